@@ -110,10 +110,34 @@ class Tree {
   /** Call a callback for every ray intersection. */
   void ray_intersect_all(const Ray &ray, FunctionRef<void(const RayHit &)> fn) const;
 
+  /**
+   * Intersect many rays against the tree. This is faster than calling #ray_intersect in a loop
+   * because rays are processed in parallel, are reordered so that rays with similar origins and
+   * directions are traced together, and are traced in packets when supported by the BVH.
+   *
+   * \param get_ray: Return the ray for an index in the mask.
+   * \param fn: Called exactly once for every index in the mask with the ray and its closest hit.
+   * It may be called from multiple threads at the same time and in any order.
+   */
+  void ray_intersect_batch(
+      const IndexMask &mask,
+      FunctionRef<Ray(int)> get_ray,
+      FunctionRef<void(int, const Ray &, const std::optional<RayHit> &)> fn) const;
+
   /** Find the closest surface point to a given position. */
   std::optional<ClosestPointResult> closest_point(
       const float3 &point, float radius = std::numeric_limits<float>::max()) const;
 
+  /**
+   * Find the closest surface point for many positions. Like #ray_intersect_batch, the queries
+   * are processed in parallel and in a spatially coherent order, and \a fn may be called from
+   * multiple threads in any order.
+   */
+  void closest_point_batch(
+      const IndexMask &mask,
+      FunctionRef<float3(int)> get_point,
+      FunctionRef<void(int, const std::optional<ClosestPointResult> &)> fn) const;
+
   /** Call a callback for every element within a given radius. */
   void range_query(const float3 &point, const float radius, FunctionRef<bool(int)> fn) const;
 };
@@ -368,6 +368,22 @@ struct SculptTopologyIslandCache {
   Array<uint8_t> vert_island_ids;
 };
 
+/**
+ * Boundary auto-masking data that only depends on topology, visibility and face sets, so it can be
+ * reused by following strokes as long as those don't change.
+ */
+struct SculptBoundaryAutomaskCache {
+  /** The #blender::bke::pbvh::Tree versions of the data the distances were calculated from. */
+  int face_sets_version;
+  int visibility_version;
+  int propagation_steps;
+  /**
+   * The number of edges from each vertex to the closest boundary, or -1 for vertices further away
+   * than #propagation_steps.
+   */
+  Array<int> edge_distance;
+};
+
 using ActiveVert = std::variant<std::monostate, int, BMVert *>;
 
 /* Helper return struct for associated data. */
@@ -510,6 +526,10 @@ struct SculptSession : NonCopyable, NonMovable {
 
   std::unique_ptr<SculptTopologyIslandCache> topology_island_cache;
 
+  /** Not used for dynamic topology, where vertex indices change during strokes. */
+  std::unique_ptr<SculptBoundaryAutomaskCache> boundary_edges_automask_cache;
+  std::unique_ptr<SculptBoundaryAutomaskCache> boundary_face_sets_automask_cache;
+
  private:
   /* In general, this value is expected to be valid (non-empty) as long as the cursor is over the
    * mesh. Changing the underlying mesh type (e.g. enabling dyntopo, changing multires levels)
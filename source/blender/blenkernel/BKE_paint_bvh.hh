@@ -253,6 +253,10 @@ class Tree {
    */
   BitVector<> visibility_dirty_;
 
+  /** Incremented whenever face sets or visibility are tagged changed. */
+  int face_sets_version_ = 0;
+  int visibility_version_ = 0;
+
  public:
   std::variant<Vector<MeshNode>, Vector<GridsNode>, Vector<BMeshNode>> nodes_;
 
@@ -297,6 +301,13 @@ class Tree {
   /** Tag nodes where face sets have changed, causing refresh of derived data. */
   void tag_face_sets_changed(const IndexMask &node_mask);
 
+  /**
+   * Counters that change whenever face sets or visibility are tagged changed. Used to validate
+   * caches of data derived from them that are kept between operations.
+   */
+  int face_sets_version() const;
+  int visibility_version() const;
+
   /** Tag nodes where mask values have changed, causing refresh of derived data. */
   void tag_masks_changed(const IndexMask &node_mask);
 
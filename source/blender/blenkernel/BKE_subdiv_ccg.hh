@@ -240,7 +240,11 @@ void BKE_subdiv_ccg_update_normals(SubdivCCG &subdiv_ccg, const IndexMask &face_
 /** Average grid coordinates and normals along the grid boundaries. */
 void BKE_subdiv_ccg_average_grids(SubdivCCG &subdiv_ccg);
 
-/** Similar to above, but only updates given faces. */
+/**
+ * Similar to above, but only updates given faces and the boundaries and corners shared with
+ * their neighbors. Use #bke::pbvh::nodes_to_face_selection_grids to find the faces of changed
+ * nodes.
+ */
 void BKE_subdiv_ccg_average_stitch_faces(SubdivCCG &subdiv_ccg, const IndexMask &face_mask);
 
 /** Get geometry counters at the current subdivision level. */
@@ -93,5 +93,31 @@ void eval_displacement(Subdiv *subdiv,
 /** Evaluate point on a limit surface with displacement applied to it. */
 float3 eval_final_point(Subdiv *subdiv, int ptex_face_index, float u, float v);
 
+/* Batched queries.
+ *
+ * Evaluate many points of the same ptex face at once. This is faster than the single point
+ * queries in a loop, because the patches are evaluated in batches by OpenSubdiv and large inputs
+ * are split up and evaluated in parallel. The results match those of the single point queries. */
+
+void eval_limit_points(Subdiv *subdiv,
+                       int ptex_face_index,
+                       Span<float2> uvs,
+                       MutableSpan<float3> r_P);
+void eval_limit_points_and_derivatives(Subdiv *subdiv,
+                                       int ptex_face_index,
+                                       Span<float2> uvs,
+                                       MutableSpan<float3> r_P,
+                                       MutableSpan<float3> r_dPdu,
+                                       MutableSpan<float3> r_dPdv);
+void eval_limit_points_and_normals(Subdiv *subdiv,
+                                   int ptex_face_index,
+                                   Span<float2> uvs,
+                                   MutableSpan<float3> r_P,
+                                   MutableSpan<float3> r_N);
+void eval_final_points(Subdiv *subdiv,
+                       int ptex_face_index,
+                       Span<float2> uvs,
+                       MutableSpan<float3> r_P);
+
 }  // namespace bke::subdiv
 }  // namespace blender
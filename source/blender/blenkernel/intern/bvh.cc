@@ -7,6 +7,8 @@
 #include "BLI_kdopbvh.hh"
 #include "BLI_math_geom_c.hh"
 #include "BLI_math_vector.hh"
+#include "BLI_morton_code.hh"
+#include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -473,6 +475,121 @@ void Tree::ray_intersect_all(const Ray &ray, FunctionRef<void(const RayHit &)> f
 #endif
 }
 
+/** Number of queries that are reordered and traced together by a single task. */
+static constexpr int64_t batch_chunk_size = 1024;
+
+/**
+ * Find an order for the queries in which queries that are close in space (and for rays, that
+ * point in the same direction octant) are next to each other. Tracing them in that order makes
+ * them visit the same BVH nodes consecutively, which is much more cache friendly than the
+ * arbitrary order of the input, and groups similar rays in the same packet.
+ */
+static void sort_queries_coherent(const Span<float3> positions,
+                                  const Span<float3> directions,
+                                  MutableSpan<int> r_order)
+{
+  if (directions.is_empty()) {
+    sort_by_morton_code(positions, r_order);
+    return;
+  }
+
+  Array<uint32_t, batch_chunk_size> codes(positions.size());
+  calc_morton_codes(positions, codes);
+  Array<uint64_t, batch_chunk_size> keys(positions.size());
+  for (const int i : positions.index_range()) {
+    const float3 &direction = directions[i];
+    const uint64_t octant = (direction.x < 0.0f ? 1 : 0) | (direction.y < 0.0f ? 2 : 0) |
+                            (direction.z < 0.0f ? 4 : 0);
+    keys[i] = (octant << 32) | codes[i];
+  }
+
+  array_utils::fill_index_range<int>(r_order);
+  std::sort(r_order.begin(), r_order.end(), [&](const int a, const int b) {
+    return keys[a] < keys[b];
+  });
+}
+
+void Tree::ray_intersect_batch(
+    const IndexMask &mask,
+    const FunctionRef<Ray(int)> get_ray,
+    const FunctionRef<void(int, const Ray &, const std::optional<RayHit> &)> fn) const
+{
+  threading::parallel_for(mask.index_range(), batch_chunk_size, [&](const IndexRange range) {
+    const IndexMask chunk = mask.slice(range);
+    Array<int, batch_chunk_size> indices(chunk.size());
+    chunk.to_indices<int>(indices);
+
+    Array<Ray> rays(chunk.size());
+    Array<float3> origins(chunk.size());
+    Array<float3> directions(chunk.size());
+    for (const int i : rays.index_range()) {
+      rays[i] = get_ray(indices[i]);
+      origins[i] = rays[i].origin;
+      directions[i] = rays[i].direction;
+    }
+    Array<int, batch_chunk_size> order(chunk.size());
+    sort_queries_coherent(origins, directions, order);
+
+#ifdef WITH_EMBREE
+    /* Trace the sorted rays in packets, which lets Embree test each node against multiple rays
+     * with SIMD instructions. */
+    constexpr int ray_packet_size = 8;
+    for (int64_t start = 0; start < order.size(); start += ray_packet_size) {
+      const int packet_size = int(std::min<int64_t>(ray_packet_size, order.size() - start));
+      RTCRayHit8 packet;
+      alignas(32) int valid[ray_packet_size];
+      for (const int lane : IndexRange(ray_packet_size)) {
+        if (lane >= packet_size) {
+          valid[lane] = 0;
+          continue;
+        }
+        const Ray &ray = rays[order[start + lane]];
+        valid[lane] = -1;
+        packet.ray.org_x[lane] = ray.origin.x;
+        packet.ray.org_y[lane] = ray.origin.y;
+        packet.ray.org_z[lane] = ray.origin.z;
+        packet.ray.dir_x[lane] = ray.direction.x;
+        packet.ray.dir_y[lane] = ray.direction.y;
+        packet.ray.dir_z[lane] = ray.direction.z;
+        packet.ray.tnear[lane] = 0.0f;
+        packet.ray.tfar[lane] = ray.dist_max;
+        packet.ray.time[lane] = 0.0f;
+        packet.ray.mask[lane] = 0xffffffff;
+        packet.ray.id[lane] = lane;
+        packet.ray.flags[lane] = 0;
+        packet.hit.geomID[lane] = RTC_INVALID_GEOMETRY_ID;
+        packet.hit.instID[0][lane] = RTC_INVALID_GEOMETRY_ID;
+      }
+      rtcIntersect8(valid, rtc_scene_, &packet);
+
+      for (const int lane : IndexRange(packet_size)) {
+        const int i = order[start + lane];
+        const uint32_t geom_id = packet.hit.geomID[lane];
+        const uint32_t prim_id = packet.hit.primID[lane];
+        if (geom_id == RTC_INVALID_GEOMETRY_ID || prim_id == RTC_INVALID_GEOMETRY_ID) {
+          fn(indices[i], rays[i], std::nullopt);
+          continue;
+        }
+        RayHit hit;
+        hit.normal = float3(
+            packet.hit.Ng_x[lane], packet.hit.Ng_y[lane], packet.hit.Ng_z[lane]);
+        hit.bary_coord = bary_coord_embree_to_blender(packet.hit.u[lane], packet.hit.v[lane]);
+        hit.index = int(prim_id);
+        if (!index_map_by_geom_[geom_id].is_empty()) {
+          hit.index = index_map_by_geom_[geom_id][hit.index];
+        }
+        hit.distance = packet.ray.tfar[lane];
+        fn(indices[i], rays[i], hit);
+      }
+    }
+#else /* WITH_EMBREE */
+    for (const int i : order) {
+      fn(indices[i], rays[i], this->ray_intersect(rays[i]));
+    }
+#endif
+  });
+}
+
 #ifdef WITH_EMBREE
 
 struct ClosestPointUserData {
@@ -579,6 +696,29 @@ std::optional<ClosestPointResult> Tree::closest_point(const float3 &point,
 #endif
 }
 
+void Tree::closest_point_batch(
+    const IndexMask &mask,
+    const FunctionRef<float3(int)> get_point,
+    const FunctionRef<void(int, const std::optional<ClosestPointResult> &)> fn) const
+{
+  threading::parallel_for(mask.index_range(), batch_chunk_size, [&](const IndexRange range) {
+    const IndexMask chunk = mask.slice(range);
+    Array<int, batch_chunk_size> indices(chunk.size());
+    chunk.to_indices<int>(indices);
+
+    Array<float3> points(chunk.size());
+    for (const int i : points.index_range()) {
+      points[i] = get_point(indices[i]);
+    }
+    Array<int, batch_chunk_size> order(chunk.size());
+    sort_queries_coherent(points, {}, order);
+
+    for (const int i : order) {
+      fn(indices[i], this->closest_point(points[i]));
+    }
+  });
+}
+
 void Tree::range_query(const float3 &point, const float radius, FunctionRef<bool(int)> fn) const
 {
 #ifdef WITH_EMBREE
@@ -1203,7 +1203,13 @@ static bool driver_compile_simple_expr(ChannelDriver *driver)
 }
 
 /* Try using the simple expression evaluator to compute the result of the driver.
- * On success, stores the result and returns true; on failure result is set to 0. */
+ * On success, stores the result and returns true; on failure result is set to 0.
+ *
+ * NOTE: Every driver is evaluated by its own depsgraph operation with its own parsed expression,
+ * so there is only ever one set of variable values to evaluate at a time. Evaluating the simple
+ * expressions of many drivers in one batch would require merging their operations into one per
+ * rig first. That adds false dependencies between drivers that currently evaluate independently,
+ * and creates cycles in rigs where drivers feed each other through bones. */
 static bool driver_try_evaluate_simple_expr(const AnimationEvalContext *anim_eval_context,
                                             ChannelDriver *driver,
                                             ChannelDriver *driver_orig,
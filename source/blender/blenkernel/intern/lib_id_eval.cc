@@ -10,6 +10,7 @@
  */
 
 #include "DNA_ID.h"
+#include "DNA_curves_types.h"
 #include "DNA_mesh_types.h"
 
 #include "BKE_lib_id.hh"
@@ -25,6 +26,17 @@ void BKE_id_eval_properties_copy(ID *id_cow, ID *id)
   if (id_type == ID_ME) {
     BKE_mesh_copy_parameters(id_cast<Mesh *>(id_cow), id_cast<const Mesh *>(id));
   }
+  else if (id_type == ID_CV) {
+    /* Only copy settings which are not animatable and don't reference other data-blocks. The
+     * evaluated copy keeps its remapped material and surface pointers, and animated values are
+     * not overwritten after animation evaluation. Other settings like the symmetry or surface
+     * options are only changed through tags that include #ID_RECALC_SYNC_TO_EVAL, which still
+     * copies the whole data-block. */
+    Curves *curves_cow = id_cast<Curves *>(id_cow);
+    const Curves *curves = id_cast<const Curves *>(id);
+    curves_cow->flag = curves->flag;
+    curves_cow->selection_domain = curves->selection_domain;
+  }
   else {
     BLI_assert_unreachable();
   }
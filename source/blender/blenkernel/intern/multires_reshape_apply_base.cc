@@ -14,6 +14,7 @@
 
 #include "BLI_math_matrix.hh"
 #include "BLI_math_vector_c.hh"
+#include "BLI_task.hh"
 
 #include "BKE_mesh.hh"
 #include "BKE_multires.hh"
@@ -29,24 +30,37 @@ void multires_reshape_apply_base_update_mesh_coords(MultiresReshapeContext *resh
   reshape_context->base_positions = base_positions;
 
   const Span<int> corner_verts = reshape_context->base_corner_verts;
+  /* Vertices are shared by multiple corners. Use the last corner of every vertex, so that the
+   * result is the same as when evaluating all corners in order. */
+  Array<int> vert_to_corner(base_positions.size(), -1);
   for (const int loop_index : corner_verts.index_range()) {
+    vert_to_corner[corner_verts[loop_index]] = loop_index;
+  }
+
+  threading::parallel_for(vert_to_corner.index_range(), 256, [&](const IndexRange range) {
+    for (const int vert : range) {
+      const int loop_index = vert_to_corner[vert];
+      if (loop_index == -1) {
+        continue;
+      }
 
-    GridCoord grid_coord;
-    grid_coord.grid_index = loop_index;
-    grid_coord.u = 1.0f;
-    grid_coord.v = 1.0f;
+      GridCoord grid_coord;
+      grid_coord.grid_index = loop_index;
+      grid_coord.u = 1.0f;
+      grid_coord.v = 1.0f;
 
-    float3 P;
-    float3x3 tangent_matrix;
-    multires_reshape_evaluate_base_mesh_limit_at_grid(
-        reshape_context, &grid_coord, P, tangent_matrix);
+      float3 P;
+      float3x3 tangent_matrix;
+      multires_reshape_evaluate_base_mesh_limit_at_grid(
+          reshape_context, &grid_coord, P, tangent_matrix);
 
-    ReshapeConstGridElement grid_element = multires_reshape_orig_grid_element_for_grid_coord(
-        reshape_context, &grid_coord);
-    const float3 D = math::transform_direction(tangent_matrix, grid_element.displacement);
+      ReshapeConstGridElement grid_element = multires_reshape_orig_grid_element_for_grid_coord(
+          reshape_context, &grid_coord);
+      const float3 D = math::transform_direction(tangent_matrix, grid_element.displacement);
 
-    base_positions[corner_verts[loop_index]] = P + D;
-  }
+      base_positions[vert] = P + D;
+    }
+  });
 }
 
 /* Assumes no is normalized; return value's sign is negative if v is on the other side of the
@@ -69,65 +83,64 @@ void multires_reshape_apply_base_refit_base_mesh(MultiresReshapeContext *reshape
   reshape_context->base_positions = base_positions;
   const GroupedSpan<int> vert_to_face_map = base_mesh->vert_to_face_map();
 
-  Array<float3> origco(base_mesh->verts_num);
-  for (int i = 0; i < base_mesh->verts_num; i++) {
-    origco[i] = base_positions[i];
-  }
+  const Array<float3> origco(base_positions.as_span());
 
-  for (int i = 0; i < base_mesh->verts_num; i++) {
-    float3 avg_no(0.0f);
-    float3 center(0.0f);
+  threading::parallel_for(base_positions.index_range(), 512, [&](const IndexRange range) {
+    for (const int i : range) {
+      float3 avg_no(0.0f);
+      float3 center(0.0f);
 
-    /* Don't adjust vertices not used by at least one face. */
-    if (vert_to_face_map[i].is_empty()) {
-      continue;
-    }
+      /* Don't adjust vertices not used by at least one face. */
+      if (vert_to_face_map[i].is_empty()) {
+        continue;
+      }
 
-    /* Find center. */
-    int tot = 0;
-    for (const int face : vert_to_face_map[i]) {
-      /* This double counts, not sure if that's bad or good. */
-      for (const int corner : reshape_context->base_faces[face]) {
-        const int vndx = reshape_context->base_corner_verts[corner];
-        if (vndx != i) {
-          center += origco[vndx];
-          tot++;
+      /* Find center. */
+      int tot = 0;
+      for (const int face : vert_to_face_map[i]) {
+        /* This double counts, not sure if that's bad or good. */
+        for (const int corner : reshape_context->base_faces[face]) {
+          const int vndx = reshape_context->base_corner_verts[corner];
+          if (vndx != i) {
+            center += origco[vndx];
+            tot++;
+          }
         }
       }
-    }
-    center *= math::rcp(float(tot));
+      center *= math::rcp(float(tot));
 
-    /* Find normal. */
-    for (int j = 0; j < vert_to_face_map[i].size(); j++) {
-      const IndexRange face = reshape_context->base_faces[vert_to_face_map[i][j]];
+      /* Find normal. */
+      for (int j = 0; j < vert_to_face_map[i].size(); j++) {
+        const IndexRange face = reshape_context->base_faces[vert_to_face_map[i][j]];
 
-      /* Set up face, loops, and coords in order to call #bke::mesh::face_normal_calc(). */
-      Array<int> face_verts(face.size());
-      Array<float3> fake_co(face.size());
+        /* Set up face, loops, and coords in order to call #bke::mesh::face_normal_calc(). */
+        Array<int> face_verts(face.size());
+        Array<float3> fake_co(face.size());
 
-      for (int k = 0; k < face.size(); k++) {
-        const int vndx = reshape_context->base_corner_verts[face[k]];
+        for (int k = 0; k < face.size(); k++) {
+          const int vndx = reshape_context->base_corner_verts[face[k]];
 
-        face_verts[k] = k;
+          face_verts[k] = k;
 
-        if (vndx == i) {
-          fake_co[k] = center;
-        }
-        else {
-          fake_co[k] = origco[vndx];
+          if (vndx == i) {
+            fake_co[k] = center;
+          }
+          else {
+            fake_co[k] = origco[vndx];
+          }
         }
+
+        const float3 no = bke::mesh::face_normal_calc(fake_co, face_verts);
+        avg_no += no;
       }
+      avg_no = math::normalize(avg_no);
 
-      const float3 no = bke::mesh::face_normal_calc(fake_co, face_verts);
-      avg_no += no;
+      /* Push vertex away from the plane. */
+      const float dist = v3_dist_from_plane(base_positions[i], center, avg_no);
+      const float3 push = avg_no * dist;
+      base_positions[i] += push;
     }
-    avg_no = math::normalize(avg_no);
-
-    /* Push vertex away from the plane. */
-    const float dist = v3_dist_from_plane(base_positions[i], center, avg_no);
-    const float3 push = avg_no * dist;
-    base_positions[i] += push;
-  }
+  });
 
   /* Vertices were moved around, need to update normals after all the vertices are updated
    * Probably this is possible to do in the loop above, but this is rather tricky because
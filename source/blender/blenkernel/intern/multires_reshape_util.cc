@@ -19,6 +19,7 @@
 #include "BLI_math_matrix.hh"
 #include "BLI_math_matrix_c.hh"
 #include "BLI_math_vector_c.hh"
+#include "BLI_task.hh"
 #include "BLI_task_c.hh"
 
 #include "BKE_attribute.hh"
@@ -326,16 +327,18 @@ void multires_reshape_free_original_grids(MultiresReshapeContext *reshape_contex
   }
 
   const int num_grids = reshape_context->num_grids;
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    if (orig_mdisps != nullptr) {
-      MDisps *orig_grid = &orig_mdisps[grid_index];
-      MEM_SAFE_DELETE(orig_grid->disps);
-    }
-    if (orig_grid_paint_masks != nullptr) {
-      GridPaintMask *orig_paint_mask_grid = &orig_grid_paint_masks[grid_index];
-      MEM_SAFE_DELETE(orig_paint_mask_grid->data);
+  threading::parallel_for(IndexRange(num_grids), 1024, [&](const IndexRange range) {
+    for (const int grid_index : range) {
+      if (orig_mdisps != nullptr) {
+        MDisps *orig_grid = &orig_mdisps[grid_index];
+        MEM_SAFE_DELETE(orig_grid->disps);
+      }
+      if (orig_grid_paint_masks != nullptr) {
+        GridPaintMask *orig_paint_mask_grid = &orig_grid_paint_masks[grid_index];
+        MEM_SAFE_DELETE(orig_paint_mask_grid->data);
+      }
     }
-  }
+  });
 
   MEM_SAFE_DELETE(orig_mdisps);
   MEM_SAFE_DELETE(orig_grid_paint_masks);
@@ -584,9 +587,11 @@ static void ensure_displacement_grids(Mesh *mesh, const int grid_level)
   const int grid_area = grid_size * grid_size;
   MDisps *mdisps = static_cast<MDisps *>(
       CustomData_get_layer_for_write(&mesh->corner_data, CD_MDISPS, mesh->corners_num));
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    ensure_displacement_grid(&mdisps[grid_index], grid_area);
-  }
+  threading::parallel_for(IndexRange(num_grids), 256, [&](const IndexRange range) {
+    for (const int grid_index : range) {
+      ensure_displacement_grid(&mdisps[grid_index], grid_area);
+    }
+  });
 }
 
 static void ensure_mask_grids(Mesh *mesh, const int level)
@@ -599,18 +604,20 @@ static void ensure_mask_grids(Mesh *mesh, const int level)
   const int num_grids = mesh->corners_num;
   const int grid_size = bke::subdiv::grid_size_from_level(level);
   const int grid_area = grid_size * grid_size;
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    GridPaintMask *grid_paint_mask = &grid_paint_masks[grid_index];
-    if (grid_paint_mask->level >= level) {
-      continue;
-    }
-    grid_paint_mask->level = level;
-    if (grid_paint_mask->data) {
-      MEM_delete(grid_paint_mask->data);
+  threading::parallel_for(IndexRange(num_grids), 256, [&](const IndexRange range) {
+    for (const int grid_index : range) {
+      GridPaintMask *grid_paint_mask = &grid_paint_masks[grid_index];
+      if (grid_paint_mask->level >= level) {
+        continue;
+      }
+      grid_paint_mask->level = level;
+      if (grid_paint_mask->data) {
+        MEM_delete(grid_paint_mask->data);
+      }
+      /* TODO(sergey): Preserve data on the old level. */
+      grid_paint_mask->data = MEM_new_array_zeroed<float>(grid_area, "gpm.data");
     }
-    /* TODO(sergey): Preserve data on the old level. */
-    grid_paint_mask->data = MEM_new_array_zeroed<float>(grid_area, "gpm.data");
-  }
+  });
 }
 
 void multires_reshape_ensure_grids(Mesh *mesh, const int level)
@@ -637,22 +644,24 @@ void multires_reshape_store_original_grids(MultiresReshapeContext *reshape_conte
   }
 
   const int num_grids = reshape_context->num_grids;
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    MDisps *orig_grid = &orig_mdisps[grid_index];
-    /* Ignore possibly invalid/non-allocated original grids. They will be replaced with 0 original
-     * data when accessed during reshape process.
-     * Reshape process will ensure all grids are on top level, but that happens on separate set of
-     * grids which eventually replaces original one. */
-    if (orig_grid->disps != nullptr) {
-      orig_grid->disps = MEM_dupalloc(orig_grid->disps);
-    }
-    if (orig_grid_paint_masks != nullptr) {
-      GridPaintMask *orig_paint_mask_grid = &orig_grid_paint_masks[grid_index];
-      if (orig_paint_mask_grid->data != nullptr) {
-        orig_paint_mask_grid->data = MEM_dupalloc(orig_paint_mask_grid->data);
+  threading::parallel_for(IndexRange(num_grids), 256, [&](const IndexRange range) {
+    for (const int grid_index : range) {
+      MDisps *orig_grid = &orig_mdisps[grid_index];
+      /* Ignore possibly invalid/non-allocated original grids. They will be replaced with 0
+       * original data when accessed during reshape process.
+       * Reshape process will ensure all grids are on top level, but that happens on separate set
+       * of grids which eventually replaces original one. */
+      if (orig_grid->disps != nullptr) {
+        orig_grid->disps = MEM_dupalloc(orig_grid->disps);
+      }
+      if (orig_grid_paint_masks != nullptr) {
+        GridPaintMask *orig_paint_mask_grid = &orig_grid_paint_masks[grid_index];
+        if (orig_paint_mask_grid->data != nullptr) {
+          orig_paint_mask_grid->data = MEM_dupalloc(orig_paint_mask_grid->data);
+        }
       }
     }
-  }
+  });
 
   reshape_context->orig.mdisps = orig_mdisps;
   reshape_context->orig.grid_paint_masks = orig_grid_paint_masks;
@@ -2067,6 +2067,8 @@ void BKE_sculptsession_free_pbvh(Object &object)
   ss->boundary_info_cache.reset();
   ss->fake_neighbors.fake_neighbor_index = {};
   ss->topology_island_cache.reset();
+  ss->boundary_edges_automask_cache.reset();
+  ss->boundary_face_sets_automask_cache.reset();
 
   ss->clear_active_elements(false);
 }
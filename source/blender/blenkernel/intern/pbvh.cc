@@ -622,6 +622,7 @@ void Tree::tag_positions_changed(const IndexMask &node_mask)
 
 void Tree::tag_visibility_changed(const IndexMask &node_mask)
 {
+  visibility_version_++;
   visibility_dirty_.resize(std::max(visibility_dirty_.size(), node_mask.min_array_size()), false);
   node_mask.set_bits(visibility_dirty_);
   if (this->draw_data) {
@@ -638,11 +639,22 @@ void Tree::tag_topology_changed(const IndexMask &node_mask)
 
 void Tree::tag_face_sets_changed(const IndexMask &node_mask)
 {
+  face_sets_version_++;
   if (this->draw_data) {
     this->draw_data->tag_face_sets_changed(node_mask);
   }
 }
 
+int Tree::face_sets_version() const
+{
+  return face_sets_version_;
+}
+
+int Tree::visibility_version() const
+{
+  return visibility_version_;
+}
+
 void Tree::tag_masks_changed(const IndexMask &node_mask)
 {
   if (this->draw_data) {
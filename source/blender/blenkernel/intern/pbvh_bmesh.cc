@@ -721,7 +721,7 @@ static bool check_mask(const EdgeQueueContext *eq_ctx, const BMVert *v)
   return BM_ELEM_CD_GET_FLOAT(v, eq_ctx->cd_vert_mask_offset) < 1.0f;
 }
 
-static void edge_queue_insert(const EdgeQueueContext *eq_ctx, BMEdge *e, const float priority)
+static bool edge_queue_allows_edge(const EdgeQueueContext *eq_ctx, const BMEdge *e)
 {
   /* Don't let topology update affect fully masked vertices. This used to
    * have a 50% mask cutoff, with the reasoning that you can't do a 50%
@@ -729,17 +729,59 @@ static void edge_queue_insert(const EdgeQueueContext *eq_ctx, BMEdge *e, const f
    * should already make the brush move the vertices only 50%, which means
    * that topology updates will also happen less frequent, that should be
    * enough. */
-  if ((eq_ctx->cd_vert_mask_offset == -1 ||
-       (check_mask(eq_ctx, e->v1) || check_mask(eq_ctx, e->v2))) &&
-      !(BM_elem_flag_test_bool(e->v1, BM_ELEM_HIDDEN) ||
-        BM_elem_flag_test_bool(e->v2, BM_ELEM_HIDDEN)))
-  {
-    BMVert **pair = static_cast<BMVert **>(BLI_mempool_alloc(eq_ctx->pool));
-    pair[0] = e->v1;
-    pair[1] = e->v2;
-    BLI_heapsimple_insert(eq_ctx->queue->heap, priority, pair);
-    BLI_assert(EDGE_QUEUE_TEST(e) == false);
-    EDGE_QUEUE_ENABLE(e);
+  return (eq_ctx->cd_vert_mask_offset == -1 ||
+          (check_mask(eq_ctx, e->v1) || check_mask(eq_ctx, e->v2))) &&
+         !(BM_elem_flag_test_bool(e->v1, BM_ELEM_HIDDEN) ||
+           BM_elem_flag_test_bool(e->v2, BM_ELEM_HIDDEN));
+}
+
+static void edge_queue_insert_unchecked(const EdgeQueueContext *eq_ctx,
+                                        BMEdge *e,
+                                        const float priority)
+{
+  BMVert **pair = static_cast<BMVert **>(BLI_mempool_alloc(eq_ctx->pool));
+  pair[0] = e->v1;
+  pair[1] = e->v2;
+  BLI_heapsimple_insert(eq_ctx->queue->heap, priority, pair);
+  BLI_assert(EDGE_QUEUE_TEST(e) == false);
+  EDGE_QUEUE_ENABLE(e);
+}
+
+static void edge_queue_insert(const EdgeQueueContext *eq_ctx, BMEdge *e, const float priority)
+{
+  if (edge_queue_allows_edge(eq_ctx, e)) {
+    edge_queue_insert_unchecked(eq_ctx, e, priority);
+  }
+}
+
+/**
+ * An edge found while scanning the nodes for the queue. The nodes are scanned in parallel without
+ * modifying the mesh, and the candidates are inserted into the queue afterwards, in the same order
+ * as if the nodes had been scanned one after another.
+ */
+struct EdgeQueueCandidate {
+  BMEdge *edge;
+  float priority;
+};
+
+static void edge_queue_candidate_add(const EdgeQueueContext *eq_ctx,
+                                     BMEdge *e,
+                                     const float priority,
+                                     Vector<EdgeQueueCandidate> &r_candidates)
+{
+  if (edge_queue_allows_edge(eq_ctx, e)) {
+    r_candidates.append({e, priority});
+  }
+}
+
+static void edge_queue_insert_candidates(const EdgeQueueContext *eq_ctx,
+                                         const Span<EdgeQueueCandidate> candidates)
+{
+  for (const EdgeQueueCandidate &candidate : candidates) {
+    /* Edges may be found multiple times, but are only added to the queue once. */
+    if (!EDGE_QUEUE_TEST(candidate.edge)) {
+      edge_queue_insert_unchecked(eq_ctx, candidate.edge, candidate.priority);
+    }
   }
 }
 
@@ -836,7 +878,8 @@ static void long_edge_queue_edge_add_recursive(const EdgeQueueContext *eq_ctx,
                                                const BMLoop *l_edge,
                                                const BMLoop *l_end,
                                                const float len_sq,
-                                               const float limit_len)
+                                               const float limit_len,
+                                               Vector<EdgeQueueCandidate> &r_candidates)
 {
   BLI_assert(len_sq > square_f(limit_len));
 
@@ -846,9 +889,7 @@ static void long_edge_queue_edge_add_recursive(const EdgeQueueContext *eq_ctx,
     }
   }
 
-  if (!EDGE_QUEUE_TEST(l_edge->e)) {
-    edge_queue_insert(eq_ctx, l_edge->e, long_edge_queue_priority(*l_edge->e));
-  }
+  edge_queue_candidate_add(eq_ctx, l_edge->e, long_edge_queue_priority(*l_edge->e), r_candidates);
 
   /* temp support previous behavior! */
   if (G.debug_value == 1234) [[unlikely]] {
@@ -875,24 +916,30 @@ static void long_edge_queue_edge_add_recursive(const EdgeQueueContext *eq_ctx,
         const float len_sq_other = BM_edge_calc_length_squared(l_adjacent[i]->e);
         if (len_sq_other > max_ff(len_sq_cmp, new_limit_len_sq)) {
           // edge_queue_insert(eq_ctx, l_adjacent[i]->e, -len_sq_other);
-          long_edge_queue_edge_add_recursive(
-              eq_ctx, l_adjacent[i]->radial_next, l_adjacent[i], len_sq_other, new_limit_len);
+          long_edge_queue_edge_add_recursive(eq_ctx,
+                                             l_adjacent[i]->radial_next,
+                                             l_adjacent[i],
+                                             len_sq_other,
+                                             new_limit_len,
+                                             r_candidates);
         }
       }
     } while ((l_iter = l_iter->radial_next) != l_end);
   }
 }
 
-static void short_edge_queue_edge_add(const EdgeQueueContext *eq_ctx, BMEdge *e)
+static void short_edge_queue_edge_add(const EdgeQueueContext *eq_ctx,
+                                      BMEdge *e,
+                                      Vector<EdgeQueueCandidate> &r_candidates)
 {
-  if (!EDGE_QUEUE_TEST(e)) {
-    if (BM_edge_calc_length_squared(e) < eq_ctx->queue->limit_len_squared) {
-      edge_queue_insert(eq_ctx, e, short_edge_queue_priority(*e));
-    }
+  if (BM_edge_calc_length_squared(e) < eq_ctx->queue->limit_len_squared) {
+    edge_queue_candidate_add(eq_ctx, e, short_edge_queue_priority(*e), r_candidates);
   }
 }
 
-static void long_edge_queue_face_add(const EdgeQueueContext *eq_ctx, BMFace *f)
+static void long_edge_queue_face_add(const EdgeQueueContext *eq_ctx,
+                                     BMFace *f,
+                                     Vector<EdgeQueueCandidate> &r_candidates)
 {
   if (eq_ctx->queue->use_front_face) {
     if (dot_v3v3(f->no, *eq_ctx->queue->view_normal) < 0.0f) {
@@ -907,14 +954,28 @@ static void long_edge_queue_face_add(const EdgeQueueContext *eq_ctx, BMFace *f)
     do {
       const float len_sq = BM_edge_calc_length_squared(l_iter->e);
       if (len_sq > eq_ctx->queue->limit_len_squared) {
-        long_edge_queue_edge_add_recursive(
-            eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->queue->limit_len);
+        long_edge_queue_edge_add_recursive(eq_ctx,
+                                           l_iter->radial_next,
+                                           l_iter,
+                                           len_sq,
+                                           eq_ctx->queue->limit_len,
+                                           r_candidates);
       }
     } while ((l_iter = l_iter->next) != l_first);
   }
 }
 
-static void short_edge_queue_face_add(const EdgeQueueContext *eq_ctx, BMFace *f)
+/** Add the long edges around a new face to the queue directly. */
+static void long_edge_queue_face_insert(const EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  Vector<EdgeQueueCandidate> candidates;
+  long_edge_queue_face_add(eq_ctx, f, candidates);
+  edge_queue_insert_candidates(eq_ctx, candidates);
+}
+
+static void short_edge_queue_face_add(const EdgeQueueContext *eq_ctx,
+                                      BMFace *f,
+                                      Vector<EdgeQueueCandidate> &r_candidates)
 {
   if (eq_ctx->queue->use_front_face) {
     if (dot_v3v3(f->no, *eq_ctx->queue->view_normal) < 0.0f) {
@@ -927,11 +988,21 @@ static void short_edge_queue_face_add(const EdgeQueueContext *eq_ctx, BMFace *f)
     const BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
     const BMLoop *l_iter = l_first;
     do {
-      short_edge_queue_edge_add(eq_ctx, l_iter->e);
+      short_edge_queue_edge_add(eq_ctx, l_iter->e, r_candidates);
     } while ((l_iter = l_iter->next) != l_first);
   }
 }
 
+/** Leaf nodes marked for topology update. */
+static IndexMask topology_update_nodes(const Span<BMeshNode> nodes, IndexMaskMemory &memory)
+{
+  return IndexMask::from_predicate(nodes.index_range(), memory, [&](const int i) {
+    const BMeshNode &node = nodes[i];
+    return (node.flag_ & Node::Leaf) && (node.flag_ & Node::UpdateTopology) &&
+           !(node.flag_ & Node::FullyHidden);
+  });
+}
+
 /**
  * Create a priority queue containing vertex pairs connected by a long
  * edge as defined by Tree.bm_max_edge_len.
@@ -973,15 +1044,18 @@ static void long_edge_queue_create(const EdgeQueueContext *eq_ctx,
     eq_ctx->queue->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (BMeshNode &node : nodes) {
-    /* Check leaf nodes marked for topology update. */
-    if ((node.flag_ & Node::Leaf) && (node.flag_ & Node::UpdateTopology) &&
-        !(node.flag_ & Node::FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces_) {
-        long_edge_queue_face_add(eq_ctx, f);
-      }
-    }
+  IndexMaskMemory memory;
+  const IndexMask nodes_to_update = topology_update_nodes(nodes, memory);
+  Array<Vector<EdgeQueueCandidate>> candidates(nodes_to_update.size());
+  nodes_to_update.foreach_index(
+      [&](const int i, const int pos) {
+        for (BMFace *f : nodes[i].bm_faces_) {
+          long_edge_queue_face_add(eq_ctx, f, candidates[pos]);
+        }
+      },
+      exec_mode::grain_size(1));
+  for (const Vector<EdgeQueueCandidate> &node_candidates : candidates) {
+    edge_queue_insert_candidates(eq_ctx, node_candidates);
   }
 }
 
@@ -1026,15 +1100,18 @@ static void short_edge_queue_create(const EdgeQueueContext *eq_ctx,
     eq_ctx->queue->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (BMeshNode &node : nodes) {
-    /* Check leaf nodes marked for topology update */
-    if ((node.flag_ & Node::Leaf) && (node.flag_ & Node::UpdateTopology) &&
-        !(node.flag_ & Node::FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces_) {
-        short_edge_queue_face_add(eq_ctx, f);
-      }
-    }
+  IndexMaskMemory memory;
+  const IndexMask nodes_to_update = topology_update_nodes(nodes, memory);
+  Array<Vector<EdgeQueueCandidate>> candidates(nodes_to_update.size());
+  nodes_to_update.foreach_index(
+      [&](const int i, const int pos) {
+        for (BMFace *f : nodes[i].bm_faces_) {
+          short_edge_queue_face_add(eq_ctx, f, candidates[pos]);
+        }
+      },
+      exec_mode::grain_size(1));
+  for (const Vector<EdgeQueueCandidate> &node_candidates : candidates) {
+    edge_queue_insert_candidates(eq_ctx, node_candidates);
   }
 }
 
@@ -1146,7 +1223,7 @@ static void pbvh_bmesh_split_edge(const EdgeQueueContext *eq_ctx,
 
     BMFace *f_new_first = pbvh_bmesh_face_create(
         bm, nodes, node_changed, cd_face_node_offset, bm_log, ni, first_tri, first_edges, f_adj);
-    long_edge_queue_face_add(eq_ctx, f_new_first);
+    long_edge_queue_face_insert(eq_ctx, f_new_first);
 
     /* Create second face (v_new, v2, v_opp). */
     const std::array<BMVert *, 3> second_tri({v_new, v2, v_opp});
@@ -1159,7 +1236,7 @@ static void pbvh_bmesh_split_edge(const EdgeQueueContext *eq_ctx,
 
     BMFace *f_new_second = pbvh_bmesh_face_create(
         bm, nodes, node_changed, cd_face_node_offset, bm_log, ni, second_tri, second_edges, f_adj);
-    long_edge_queue_face_add(eq_ctx, f_new_second);
+    long_edge_queue_face_insert(eq_ctx, f_new_second);
 
     /* Delete original */
     pbvh_bmesh_face_remove(
@@ -93,64 +93,52 @@ static void subdiv_ccg_alloc_elements(SubdivCCG &subdiv_ccg,
 /** \name Grids evaluation
  * \{ */
 
-static void subdiv_ccg_eval_grid_element_limit(Subdiv &subdiv,
-                                               SubdivCCG &subdiv_ccg,
-                                               const int ptex_face_index,
-                                               const float u,
-                                               const float v,
-                                               const int element)
-{
+/**
+ * Evaluate all elements of a grid at once, \a uvs are the ptex face coordinates of the grid
+ * elements.
+ */
+static void subdiv_ccg_eval_grid(Subdiv &subdiv,
+                                 SubdivCCG &subdiv_ccg,
+                                 SubdivCCGMaskEvaluator *mask_evaluator,
+                                 const int ptex_face_index,
+                                 const Span<float2> uvs,
+                                 const IndexRange range)
+{
+  MutableSpan<float3> positions = subdiv_ccg.positions.as_mutable_span().slice(range);
   if (subdiv.displacement_evaluator != nullptr) {
-    subdiv_ccg.positions[element] = eval_final_point(&subdiv, ptex_face_index, u, v);
+    eval_final_points(&subdiv, ptex_face_index, uvs, positions);
   }
   else if (!subdiv_ccg.normals.is_empty()) {
-    eval_limit_point_and_normal(&subdiv,
-                                ptex_face_index,
-                                u,
-                                v,
-                                subdiv_ccg.positions[element],
-                                subdiv_ccg.normals[element]);
+    eval_limit_points_and_normals(&subdiv,
+                                  ptex_face_index,
+                                  uvs,
+                                  positions,
+                                  subdiv_ccg.normals.as_mutable_span().slice(range));
   }
   else {
-    subdiv_ccg.positions[element] = eval_limit_point(&subdiv, ptex_face_index, u, v);
+    eval_limit_points(&subdiv, ptex_face_index, uvs, positions);
   }
-}
 
-static void subdiv_ccg_eval_grid_element_mask(SubdivCCG &subdiv_ccg,
-                                              SubdivCCGMaskEvaluator *mask_evaluator,
-                                              const int ptex_face_index,
-                                              const float u,
-                                              const float v,
-                                              const int element)
-{
   if (subdiv_ccg.masks.is_empty()) {
     return;
   }
+  MutableSpan<float> masks = subdiv_ccg.masks.as_mutable_span().slice(range);
   if (mask_evaluator != nullptr) {
-    subdiv_ccg.masks[element] = mask_evaluator->eval_mask(mask_evaluator, ptex_face_index, u, v);
+    for (const int i : uvs.index_range()) {
+      masks[i] = mask_evaluator->eval_mask(mask_evaluator, ptex_face_index, uvs[i].x, uvs[i].y);
+    }
   }
   else {
-    subdiv_ccg.masks[element] = 0.0f;
+    masks.fill(0.0f);
   }
 }
 
-static void subdiv_ccg_eval_grid_element(Subdiv &subdiv,
-                                         SubdivCCG &subdiv_ccg,
-                                         SubdivCCGMaskEvaluator *mask_evaluator,
-                                         const int ptex_face_index,
-                                         const float u,
-                                         const float v,
-                                         const int element)
-{
-  subdiv_ccg_eval_grid_element_limit(subdiv, subdiv_ccg, ptex_face_index, u, v, element);
-  subdiv_ccg_eval_grid_element_mask(subdiv_ccg, mask_evaluator, ptex_face_index, u, v, element);
-}
-
 static void subdiv_ccg_eval_regular_grid(Subdiv &subdiv,
                                          SubdivCCG &subdiv_ccg,
                                          const Span<int> face_ptex_offset,
                                          SubdivCCGMaskEvaluator *mask_evaluator,
-                                         const int face_index)
+                                         const int face_index,
+                                         MutableSpan<float2> uvs)
 {
   const int ptex_face_index = face_ptex_offset[face_index];
   const int grid_size = subdiv_ccg.grid_size;
@@ -159,18 +147,20 @@ static void subdiv_ccg_eval_regular_grid(Subdiv &subdiv,
   const IndexRange face = subdiv_ccg.faces[face_index];
   for (int corner = 0; corner < face.size(); corner++) {
     const int grid_index = face.start() + corner;
-    const IndexRange range = grid_range(grid_area, grid_index);
     for (int y = 0; y < grid_size; y++) {
       const float grid_v = y * grid_size_1_inv;
       for (int x = 0; x < grid_size; x++) {
         const float grid_u = x * grid_size_1_inv;
-        float u, v;
-        rotate_grid_to_quad(corner, grid_u, grid_v, &u, &v);
-        const int element = range[CCG_grid_xy_to_index(grid_size, x, y)];
-        subdiv_ccg_eval_grid_element(
-            subdiv, subdiv_ccg, mask_evaluator, ptex_face_index, u, v, element);
+        float2 &uv = uvs[CCG_grid_xy_to_index(grid_size, x, y)];
+        rotate_grid_to_quad(corner, grid_u, grid_v, &uv.x, &uv.y);
       }
     }
+    subdiv_ccg_eval_grid(subdiv,
+                         subdiv_ccg,
+                         mask_evaluator,
+                         ptex_face_index,
+                         uvs,
+                         grid_range(grid_area, grid_index));
   }
 }
 
@@ -178,25 +168,30 @@ static void subdiv_ccg_eval_special_grid(Subdiv &subdiv,
                                          SubdivCCG &subdiv_ccg,
                                          const Span<int> face_ptex_offset,
                                          SubdivCCGMaskEvaluator *mask_evaluator,
-                                         const int face_index)
+                                         const int face_index,
+                                         MutableSpan<float2> uvs)
 {
   const int grid_size = subdiv_ccg.grid_size;
   const int grid_area = subdiv_ccg.grid_area;
   const float grid_size_1_inv = 1.0f / (grid_size - 1);
   const IndexRange face = subdiv_ccg.faces[face_index];
+  /* The ptex coordinates are the same for all corners. */
+  for (int y = 0; y < grid_size; y++) {
+    const float u = 1.0f - (y * grid_size_1_inv);
+    for (int x = 0; x < grid_size; x++) {
+      const float v = 1.0f - (x * grid_size_1_inv);
+      uvs[CCG_grid_xy_to_index(grid_size, x, y)] = float2(u, v);
+    }
+  }
   for (int corner = 0; corner < face.size(); corner++) {
     const int grid_index = face.start() + corner;
     const int ptex_face_index = face_ptex_offset[face_index] + corner;
-    const IndexRange range = grid_range(grid_area, grid_index);
-    for (int y = 0; y < grid_size; y++) {
-      const float u = 1.0f - (y * grid_size_1_inv);
-      for (int x = 0; x < grid_size; x++) {
-        const float v = 1.0f - (x * grid_size_1_inv);
-        const int element = range[CCG_grid_xy_to_index(grid_size, x, y)];
-        subdiv_ccg_eval_grid_element(
-            subdiv, subdiv_ccg, mask_evaluator, ptex_face_index, u, v, element);
-      }
-    }
+    subdiv_ccg_eval_grid(subdiv,
+                         subdiv_ccg,
+                         mask_evaluator,
+                         ptex_face_index,
+                         uvs,
+                         grid_range(grid_area, grid_index));
   }
 }
 
@@ -209,14 +204,15 @@ static bool subdiv_ccg_evaluate_grids(SubdivCCG &subdiv_ccg,
   const Span<int> face_ptex_offset = face_ptex_offset_get(&subdiv);
   BLI_assert(face_ptex_offset.size() == subdiv_ccg.faces.size() + 1);
   threading::parallel_for(IndexRange(num_faces), 1024, [&](const IndexRange range) {
+    Array<float2> uvs(subdiv_ccg.grid_area);
     for (const int face_index : range) {
       if (subdiv_ccg.faces[face_index].size() == 4) {
         subdiv_ccg_eval_regular_grid(
-            subdiv, subdiv_ccg, face_ptex_offset, mask_evaluator, face_index);
+            subdiv, subdiv_ccg, face_ptex_offset, mask_evaluator, face_index, uvs);
       }
       else {
         subdiv_ccg_eval_special_grid(
-            subdiv, subdiv_ccg, face_ptex_offset, mask_evaluator, face_index);
+            subdiv, subdiv_ccg, face_ptex_offset, mask_evaluator, face_index, uvs);
       }
     }
   });
@@ -802,12 +798,9 @@ static void subdiv_ccg_average_corners(SubdivCCG &subdiv_ccg,
 void BKE_subdiv_ccg_average_grids(SubdivCCG &subdiv_ccg)
 {
 #ifdef WITH_OPENSUBDIV
-  const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
   /* Average inner boundaries of grids (within one face), across faces
    * from different face-corners. */
   BKE_subdiv_ccg_average_stitch_faces(subdiv_ccg, subdiv_ccg.faces.index_range());
-  subdiv_ccg_average_boundaries(subdiv_ccg, key, subdiv_ccg.adjacent_edges.index_range());
-  subdiv_ccg_average_corners(subdiv_ccg, key, subdiv_ccg.adjacent_verts.index_range());
 #else
   UNUSED_VARS(subdiv_ccg);
 #endif
@@ -815,45 +808,51 @@ void BKE_subdiv_ccg_average_grids(SubdivCCG &subdiv_ccg)
 
 #ifdef WITH_OPENSUBDIV
 
-static void subdiv_ccg_affected_face_adjacency(SubdivCCG &subdiv_ccg,
+/**
+ * Find the base mesh vertices and edges of the given faces. Like #nodes_to_face_selection_grids,
+ * boolean arrays are used for deduplication so that the faces can be processed in parallel.
+ */
+static void subdiv_ccg_affected_face_adjacency(const SubdivCCG &subdiv_ccg,
                                                const IndexMask &face_mask,
-                                               Set<int> &adjacent_verts,
-                                               Set<int> &adjacent_edges)
+                                               IndexMaskMemory &memory,
+                                               IndexMask &r_adjacent_verts,
+                                               IndexMask &r_adjacent_edges)
 {
-  Subdiv *subdiv = subdiv_ccg.subdiv;
+  const Subdiv *subdiv = subdiv_ccg.subdiv;
   const opensubdiv::TopologyRefinerImpl *topology_refiner = subdiv->topology_refiner;
 
-  face_mask.foreach_index([&](const int face_index) {
-    const OpenSubdiv::Far::ConstIndexArray face_vertices =
-        topology_refiner->base_level().GetFaceVertices(face_index);
-    adjacent_verts.add_multiple({face_vertices.begin(), face_vertices.size()});
-
-    const OpenSubdiv::Far::ConstIndexArray face_edges =
-        topology_refiner->base_level().GetFaceEdges(face_index);
-    adjacent_edges.add_multiple({face_edges.begin(), face_edges.size()});
-  });
+  Array<bool> adjacent_verts(subdiv_ccg.adjacent_verts.size(), false);
+  Array<bool> adjacent_edges(subdiv_ccg.adjacent_edges.size(), false);
+  face_mask.foreach_index(
+      [&](const int face_index) {
+        for (const int vert : topology_refiner->base_level().GetFaceVertices(face_index)) {
+          adjacent_verts[vert] = true;
+        }
+        for (const int edge : topology_refiner->base_level().GetFaceEdges(face_index)) {
+          adjacent_edges[edge] = true;
+        }
+      },
+      exec_mode::grain_size(1024));
+  r_adjacent_verts = IndexMask::from_bools(adjacent_verts, memory);
+  r_adjacent_edges = IndexMask::from_bools(adjacent_edges, memory);
 }
 
 void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG &subdiv_ccg,
                                                      const CCGKey &key,
                                                      const IndexMask &face_mask)
 {
-  Set<int> adjacent_vert_set;
-  Set<int> adjacent_edge_set;
-  subdiv_ccg_affected_face_adjacency(subdiv_ccg, face_mask, adjacent_vert_set, adjacent_edge_set);
-
-  Vector<int> adjacent_verts(adjacent_vert_set.begin(), adjacent_vert_set.end());
-  Vector<int> adjacent_edges(adjacent_edge_set.begin(), adjacent_edge_set.end());
-
-  std::ranges::sort(adjacent_verts);
-  std::ranges::sort(adjacent_edges);
-
+  if (face_mask.size() == subdiv_ccg.faces.size()) {
+    subdiv_ccg_average_boundaries(subdiv_ccg, key, subdiv_ccg.adjacent_edges.index_range());
+    subdiv_ccg_average_corners(subdiv_ccg, key, subdiv_ccg.adjacent_verts.index_range());
+    return;
+  }
   IndexMaskMemory memory;
-  subdiv_ccg_average_boundaries(
-      subdiv_ccg, key, IndexMask::from_indices(adjacent_edges.as_span(), memory));
-
-  subdiv_ccg_average_corners(
-      subdiv_ccg, key, IndexMask::from_indices(adjacent_verts.as_span(), memory));
+  IndexMask adjacent_verts;
+  IndexMask adjacent_edges;
+  subdiv_ccg_affected_face_adjacency(
+      subdiv_ccg, face_mask, memory, adjacent_verts, adjacent_edges);
+  subdiv_ccg_average_boundaries(subdiv_ccg, key, adjacent_edges);
+  subdiv_ccg_average_corners(subdiv_ccg, key, adjacent_verts);
 }
 
 #endif
@@ -867,10 +866,8 @@ void BKE_subdiv_ccg_average_stitch_faces(SubdivCCG &subdiv_ccg, const IndexMask
         subdiv_ccg_average_inner_face_grids(subdiv_ccg, key, subdiv_ccg.faces[face_index]);
       },
       exec_mode::grain_size(512));
-  /* TODO(sergey): Only average elements which are adjacent to modified
-   * faces. */
-  subdiv_ccg_average_boundaries(subdiv_ccg, key, subdiv_ccg.adjacent_edges.index_range());
-  subdiv_ccg_average_corners(subdiv_ccg, key, subdiv_ccg.adjacent_verts.index_range());
+  /* Only boundaries and corners of the base mesh that are adjacent to the faces can change. */
+  subdiv_ccg_average_faces_boundaries_and_corners(subdiv_ccg, key, face_mask);
 #else
   UNUSED_VARS(subdiv_ccg, face_mask);
 #endif
@@ -1575,19 +1572,18 @@ void BKE_subdiv_ccg_eval_limit_positions(const SubdivCCG &subdiv_ccg,
 {
   SubdivCCGCoord coord{};
   coord.grid_index = grid_index;
+  /* All elements of a grid are on the same ptex face. */
+  int ptex_face_index = 0;
+  Array<float2> uvs(key.grid_area);
   for (const int y : IndexRange(key.grid_size)) {
     for (const int x : IndexRange(key.grid_size)) {
       const int i = CCG_grid_xy_to_index(key.grid_size, x, y);
       coord.x = x;
       coord.y = y;
-
-      int ptex_face_index;
-      float u, v;
-      subdiv_ccg_coord_to_ptex_coord(subdiv_ccg, coord, ptex_face_index, u, v);
-
-      r_limit_positions[i] = eval_limit_point(subdiv_ccg.subdiv, ptex_face_index, u, v);
+      subdiv_ccg_coord_to_ptex_coord(subdiv_ccg, coord, ptex_face_index, uvs[i].x, uvs[i].y);
     }
   }
+  eval_limit_points(subdiv_ccg.subdiv, ptex_face_index, uvs, r_limit_positions);
 }
 
 /** \} */
@@ -9,9 +9,11 @@
 #include "BKE_attribute.hh"
 #include "BKE_subdiv_eval.hh"
 
+#include "BLI_array.hh"
 #include "BLI_array_utils.hh"
 #include "BLI_math_vector.hh"
 #include "BLI_math_vector_c.hh"
+#include "BLI_task.hh"
 #include "BLI_task_c.hh"
 
 #include "BKE_customdata.hh"
@@ -397,4 +399,135 @@ float3 eval_final_point(Subdiv *subdiv, const int ptex_face_index, const float u
   return r_P;
 }
 
+/* --------------------------------------------------------------------
+ * Batched queries.
+ */
+
+#ifdef WITH_OPENSUBDIV
+
+/** Number of points passed to OpenSubdiv at once, so that the patch coordinates stay small. */
+static constexpr int64_t eval_batch_size = 1024;
+/** Only split up larger inputs, callers often already evaluate different faces in parallel. */
+static constexpr int64_t eval_parallel_grain_size = 4096;
+
+static bool derivatives_are_degenerate(const float3 &dPdu, const float3 &dPdv)
+{
+  return math::is_zero(dPdu) || math::is_zero(dPdv) || math::is_equal(dPdu, dPdv);
+}
+
+/**
+ * Evaluate the limit surface for all points in batches. The derivatives are either both null or
+ * both non-null.
+ */
+static void eval_limit_points_impl(Subdiv &subdiv,
+                                   const int ptex_face_index,
+                                   const Span<float2> uvs,
+                                   float3 *r_P,
+                                   float3 *r_dPdu,
+                                   float3 *r_dPdv)
+{
+  const IndexRange all_points = uvs.index_range();
+  threading::parallel_for(all_points, eval_parallel_grain_size, [&](const IndexRange range) {
+    Array<OpenSubdiv_PatchCoord, 0> patch_coords(std::min(range.size(), eval_batch_size));
+    for (int64_t offset = 0; offset < range.size(); offset += eval_batch_size) {
+      const int64_t batch_size = std::min(eval_batch_size, range.size() - offset);
+      const IndexRange batch = range.slice(offset, batch_size);
+      for (const int64_t i : batch.index_range()) {
+        const float2 &uv = uvs[batch[i]];
+        patch_coords[i] = {ptex_face_index, uv.x, uv.y};
+      }
+      subdiv.evaluator->eval_output->evaluatePatchesLimit(
+          patch_coords.data(),
+          int(batch.size()),
+          &r_P[batch.start()].x,
+          r_dPdu ? &r_dPdu[batch.start()].x : nullptr,
+          r_dPdv ? &r_dPdv[batch.start()].x : nullptr);
+    }
+    if (r_dPdu == nullptr) {
+      return;
+    }
+    /* Same as in #eval_limit_point_and_derivatives, degenerate derivatives are rare so they are
+     * fixed up one by one. */
+    for (const int64_t i : range) {
+      if (derivatives_are_degenerate(r_dPdu[i], r_dPdv[i])) {
+        const float2 &uv = uvs[i];
+        subdiv.evaluator->eval_output->evaluateLimit(ptex_face_index,
+                                                     uv.x * 0.999f + 0.0005f,
+                                                     uv.y * 0.999f + 0.0005f,
+                                                     r_P[i],
+                                                     r_dPdu[i],
+                                                     r_dPdv[i]);
+      }
+    }
+  });
+}
+
+#endif
+
+void eval_limit_points(Subdiv *subdiv,
+                       const int ptex_face_index,
+                       const Span<float2> uvs,
+                       MutableSpan<float3> r_P)
+{
+  BLI_assert(r_P.size() == uvs.size());
+#ifdef WITH_OPENSUBDIV
+  eval_limit_points_impl(*subdiv, ptex_face_index, uvs, r_P.data(), nullptr, nullptr);
+#else
+  UNUSED_VARS(subdiv, ptex_face_index, uvs);
+  r_P.fill(float3(0.0f));
+#endif
+}
+
+void eval_limit_points_and_derivatives(Subdiv *subdiv,
+                                       const int ptex_face_index,
+                                       const Span<float2> uvs,
+                                       MutableSpan<float3> r_P,
+                                       MutableSpan<float3> r_dPdu,
+                                       MutableSpan<float3> r_dPdv)
+{
+  BLI_assert(r_P.size() == uvs.size());
+  BLI_assert(r_dPdu.size() == uvs.size());
+  BLI_assert(r_dPdv.size() == uvs.size());
+#ifdef WITH_OPENSUBDIV
+  eval_limit_points_impl(
+      *subdiv, ptex_face_index, uvs, r_P.data(), r_dPdu.data(), r_dPdv.data());
+#else
+  UNUSED_VARS(subdiv, ptex_face_index, uvs, r_P, r_dPdu, r_dPdv);
+#endif
+}
+
+void eval_limit_points_and_normals(Subdiv *subdiv,
+                                   const int ptex_face_index,
+                                   const Span<float2> uvs,
+                                   MutableSpan<float3> r_P,
+                                   MutableSpan<float3> r_N)
+{
+  BLI_assert(r_N.size() == uvs.size());
+  Array<float3> dPdu(uvs.size());
+  Array<float3> dPdv(uvs.size());
+  eval_limit_points_and_derivatives(subdiv, ptex_face_index, uvs, r_P, dPdu, dPdv);
+  for (const int64_t i : uvs.index_range()) {
+    r_N[i] = math::normalize(math::cross(dPdu[i], dPdv[i]));
+  }
+}
+
+void eval_final_points(Subdiv *subdiv,
+                       const int ptex_face_index,
+                       const Span<float2> uvs,
+                       MutableSpan<float3> r_P)
+{
+  if (subdiv->displacement_evaluator == nullptr) {
+    eval_limit_points(subdiv, ptex_face_index, uvs, r_P);
+    return;
+  }
+  Array<float3> dPdu(uvs.size());
+  Array<float3> dPdv(uvs.size());
+  eval_limit_points_and_derivatives(subdiv, ptex_face_index, uvs, r_P, dPdu, dPdv);
+  for (const int64_t i : uvs.index_range()) {
+    float3 D;
+    eval_displacement(subdiv, ptex_face_index, uvs[i].x, uvs[i].y, dPdu[i], dPdv[i], D);
+    r_P[i] += D;
+  }
+}
+
 }  // namespace blender::bke::subdiv
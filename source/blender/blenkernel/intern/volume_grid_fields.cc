@@ -4,6 +4,9 @@
 
 #include "BKE_geometry_fields.hh"
 #include "BKE_volume_grid_fields.hh"
+#include "BKE_volume_openvdb.hh"
+
+#include "BLI_math_matrix.hh"
 
 #include "BLT_translation.hh"
 
@@ -27,13 +30,25 @@ GVArray VoxelFieldContext::get_varray_for_input(const fn::FieldInput &field_inpu
     if (attribute_field->attribute_name() == "position") {
       /* Support retrieving voxel positions. */
       Array<float3> positions(voxels_.size());
-      threading::parallel_for(positions.index_range(), 1024, [&](const IndexRange range) {
-        for (const int64_t i : range) {
-          const openvdb::Coord &voxel = voxels_[i];
-          const openvdb::Vec3d position = transform_.indexToWorld(voxel);
-          positions[i] = float3(position.x(), position.y(), position.z());
-        }
-      });
+      if (transform_.isLinear()) {
+        /* Avoid the virtual call for every voxel in the common case of an affine transform. */
+        const float4x4 index_to_world = BKE_volume_transform_to_blender(transform_);
+        mask.foreach_index_optimized<int64_t>(
+            [&](const int64_t i) {
+              const openvdb::Coord &voxel = voxels_[i];
+              positions[i] = math::transform_point(index_to_world,
+                                                   float3(voxel.x(), voxel.y(), voxel.z()));
+            },
+            exec_mode::parallel);
+      }
+      else {
+        mask.foreach_index_optimized<int64_t>(
+            [&](const int64_t i) {
+              const openvdb::Vec3d position = transform_.indexToWorld(voxels_[i]);
+              positions[i] = float3(position.x(), position.y(), position.z());
+            },
+            exec_mode::grain_size(1024));
+      }
       return VArray<float3>::from_container(std::move(positions));
     }
   }
@@ -93,14 +93,13 @@ BLI_NOINLINE static void process_leaf_node(const mf::MultiFunction &fn,
 
         if (const auto *leaf_node = tree.probeLeaf(any_voxel_in_leaf)) {
           /* Boolean grids are special because they encode the values as bitmask. So create a
-           * temporary buffer for the inputs. */
+           * temporary buffer for the inputs. The indices in the mask are offsets in the leaf, so
+           * the values can be read from the leaf directly without traversing the tree. */
           if constexpr (std::is_same_v<ValueT, bool>) {
-            const Span<openvdb::Coord> voxels = ensure_voxel_coords();
             MutableSpan<bool> values = scope.allocator().allocate_array<bool>(
                 index_mask.min_array_size());
             index_mask.foreach_index_optimized<int64_t>([&](const int64_t i) {
-              const openvdb::Coord &coord = voxels[i];
-              values[i] = tree.getValue(coord);
+              values[i] = leaf_node->getValue(openvdb::Index(i));
             });
             params.add_readonly_single_input(values);
           }
@@ -196,13 +195,15 @@ BLI_NOINLINE static void process_leaf_node(const mf::MultiFunction &fn,
     const int param_index = input_values.size() + output_i;
     const mf::ParamType param_type = fn.param_type(param_index);
     const CPPType &param_cpp_type = param_type.data_type().single_type();
-    if (!param_cpp_type.is<bool>()) {
+    if (!param_cpp_type.is<bool>() || !output_grids[output_i]) {
       continue;
     }
-    set_mask_leaf_buffer_from_bools(static_cast<openvdb::BoolGrid &>(*output_grids[output_i]),
-                                    params.computed_array(param_index).typed<bool>(),
-                                    index_mask,
-                                    ensure_voxel_coords());
+    auto &grid = static_cast<openvdb::BoolGrid &>(*output_grids[output_i]);
+    auto *leaf_node = grid.tree().probeLeaf(any_voxel_in_leaf);
+    const Span<bool> values = params.computed_array(param_index).typed<bool>();
+    index_mask.foreach_index_optimized<int64_t>([&](const int64_t i) {
+      leaf_node->setValueOnly(openvdb::Index(i), values[i]);
+    });
   }
 }
 
@@ -12,10 +12,13 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_kdtree_types.hh"
 #include "BLI_math_base_c.hh"
 #include "BLI_math_vector.hh"
+#include "BLI_morton_code.hh"
 #include "BLI_stack.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "PRF_profile.hh"
@@ -38,6 +41,12 @@ constexpr uint kd_node_unset = (uint(-1));
  */
 constexpr uint kd_node_root_is_init = (uint(-2));
 
+/** Sub-trees with fewer nodes are balanced on a single thread. */
+constexpr uint kd_balance_parallel_threshold = 8192;
+
+/** Number of queries that are reordered and processed together by a single task. */
+constexpr int64_t kd_batch_chunk_size = 1024;
+
 template<typename CoordT>
 inline typename KDTreeCoordTraits<CoordT>::ValueType axis_get(const CoordT &co, uint axis)
 {
@@ -167,13 +176,18 @@ static uint kdtree_balance(KDTreeNode<CoordT> *nodes, uint nodes_len, uint axis,
     }
   }
 
-  /* Set node and sort sub-nodes. */
+  /* Set node and sort sub-nodes. Both halves use separate parts of the array, so they can be
+   * balanced in parallel. */
   node = &nodes[median];
   node->d = axis;
   axis = (axis + 1) % KDTree<CoordT>::DimsNum;
-  node->left = kdtree_balance(nodes, median, axis, ofs);
-  node->right = kdtree_balance(
-      nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+  threading::parallel_invoke(
+      nodes_len > kd_balance_parallel_threshold,
+      [&]() { node->left = kdtree_balance(nodes, median, axis, ofs); },
+      [&]() {
+        node->right = kdtree_balance(
+            nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+      });
 
   return median + ofs;
 }
@@ -636,6 +650,57 @@ inline void kdtree_range_search_cb(const KDTree<CoordT> *tree,
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Queries
+ *
+ * Run the same query for many positions at once, distributing the work over multiple threads.
+ * The queries of every chunk are sorted by their Morton code first, so that consecutive queries
+ * traverse similar parts of the tree, which keeps those nodes in the CPU cache.
+ * \{ */
+
+/**
+ * Batched version of #kdtree_find_nearest_cb.
+ *
+ * \param filter_cb: Same as for #kdtree_find_nearest_cb, but receives the index of the query
+ * position as first argument. It is called from multiple threads.
+ * \param r_indices: The nearest index for every position in \a mask, or -1 if none was found.
+ */
+template<typename CoordT, typename Filter>
+inline void kdtree_find_nearest_batch_cb(const KDTree<CoordT> *tree,
+                                         const Span<CoordT> positions,
+                                         const IndexMask &mask,
+                                         MutableSpan<int> r_indices,
+                                         Filter &&filter_cb)
+{
+  using ValueType = typename KDTree<CoordT>::ValueType;
+  threading::parallel_for(
+      mask.index_range(), detail::kd_batch_chunk_size, [&](const IndexRange range) {
+        const IndexMask chunk = mask.slice(range);
+        Array<int, detail::kd_batch_chunk_size> indices(chunk.size());
+        chunk.to_indices<int>(indices);
+
+        Array<CoordT> chunk_positions(chunk.size());
+        for (const int i : indices.index_range()) {
+          chunk_positions[i] = positions[indices[i]];
+        }
+        Array<int, detail::kd_batch_chunk_size> order(chunk.size());
+        sort_by_morton_code(chunk_positions.as_span(), order);
+
+        for (const int i : order) {
+          const int query_i = indices[i];
+          r_indices[query_i] = kdtree_find_nearest_cb<CoordT>(
+              tree,
+              positions[query_i],
+              nullptr,
+              [&](const int index, const CoordT &co, const ValueType dist_sq) {
+                return filter_cb(query_i, index, co, dist_sq);
+              });
+        }
+      });
+}
+
+/** \} */
+
 namespace detail {
 
 /**
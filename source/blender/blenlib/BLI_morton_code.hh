@@ -0,0 +1,37 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Morton codes order positions along a Z-order curve. Positions that are close in space usually
+ * get codes that are close as well, so sorting by them gives a spatially coherent order. That is
+ * useful to run many queries on an acceleration structure, because consecutive queries then visit
+ * the same nodes of the structure, which keeps them in the CPU cache.
+ */
+
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+
+namespace blender {
+
+/**
+ * Compute the Morton code of every position, relative to the bounds of all positions.
+ */
+void calc_morton_codes(Span<float> positions, MutableSpan<uint32_t> r_codes);
+void calc_morton_codes(Span<float2> positions, MutableSpan<uint32_t> r_codes);
+void calc_morton_codes(Span<float3> positions, MutableSpan<uint32_t> r_codes);
+void calc_morton_codes(Span<float4> positions, MutableSpan<uint32_t> r_codes);
+
+/**
+ * Fill \a r_order with the indices of all positions, sorted by their Morton code.
+ */
+void sort_by_morton_code(Span<float> positions, MutableSpan<int> r_order);
+void sort_by_morton_code(Span<float2> positions, MutableSpan<int> r_order);
+void sort_by_morton_code(Span<float3> positions, MutableSpan<int> r_order);
+void sort_by_morton_code(Span<float4> positions, MutableSpan<int> r_order);
+
+}  // namespace blender
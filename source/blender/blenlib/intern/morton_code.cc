@@ -0,0 +1,127 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "BLI_array.hh"
+#include "BLI_array_utils.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_morton_code.hh"
+
+namespace blender {
+
+/** Insert two zero bits between each of the lower 10 bits of the value. */
+static uint32_t expand_bits_3d(uint32_t v)
+{
+  v = (v * 0x00010001u) & 0xFF0000FFu;
+  v = (v * 0x00000101u) & 0x0F00F00Fu;
+  v = (v * 0x00000011u) & 0xC30C30C3u;
+  v = (v * 0x00000005u) & 0x49249249u;
+  return v;
+}
+
+/** Interleave the lower bits of the cells of all axes, starting with the first axis. */
+template<int Size> static uint32_t interleave_bits(const VecBase<uint32_t, Size> &cell)
+{
+  if constexpr (Size == 3) {
+    return (expand_bits_3d(cell.x) << 2) | (expand_bits_3d(cell.y) << 1) |
+           expand_bits_3d(cell.z);
+  }
+  else {
+    constexpr int bits_per_axis = 32 / Size;
+    uint32_t code = 0;
+    for (int bit = bits_per_axis - 1; bit >= 0; bit--) {
+      for (int axis = 0; axis < Size; axis++) {
+        code = (code << 1) | ((cell[axis] >> bit) & 1u);
+      }
+    }
+    return code;
+  }
+}
+
+template<int Size>
+static void calc_morton_codes_impl(const Span<VecBase<float, Size>> positions,
+                                   MutableSpan<uint32_t> r_codes)
+{
+  using VecT = VecBase<float, Size>;
+  BLI_assert(positions.size() == r_codes.size());
+  constexpr int bits_per_axis = 32 / Size;
+  constexpr double cells_max = double((uint64_t(1) << bits_per_axis) - 1);
+
+  VecT min(std::numeric_limits<float>::max());
+  VecT max(std::numeric_limits<float>::lowest());
+  for (const VecT &position : positions) {
+    math::min_max(position, min, max);
+  }
+  const VecT inv_size = math::safe_rcp(max - min);
+
+  for (const int64_t i : positions.index_range()) {
+    const VecT normalized = math::clamp((positions[i] - min) * inv_size, VecT(0.0f), VecT(1.0f));
+    VecBase<uint32_t, Size> cell;
+    for (int axis = 0; axis < Size; axis++) {
+      /* Use double precision, because a float can't represent all 32 bit cells in 1D. */
+      cell[axis] = uint32_t(double(normalized[axis]) * cells_max);
+    }
+    r_codes[i] = interleave_bits(cell);
+  }
+}
+
+void calc_morton_codes(const Span<float> positions, MutableSpan<uint32_t> r_codes)
+{
+  calc_morton_codes_impl<1>(positions.cast<VecBase<float, 1>>(), r_codes);
+}
+
+void calc_morton_codes(const Span<float2> positions, MutableSpan<uint32_t> r_codes)
+{
+  calc_morton_codes_impl<2>(positions, r_codes);
+}
+
+void calc_morton_codes(const Span<float3> positions, MutableSpan<uint32_t> r_codes)
+{
+  calc_morton_codes_impl<3>(positions, r_codes);
+}
+
+void calc_morton_codes(const Span<float4> positions, MutableSpan<uint32_t> r_codes)
+{
+  calc_morton_codes_impl<4>(positions, r_codes);
+}
+
+template<typename T>
+static void sort_by_morton_code_impl(const Span<T> positions, MutableSpan<int> r_order)
+{
+  BLI_assert(positions.size() == r_order.size());
+  Array<uint32_t> codes(positions.size());
+  calc_morton_codes(positions, codes);
+  array_utils::fill_index_range<int>(r_order);
+  std::sort(r_order.begin(), r_order.end(), [&](const int a, const int b) {
+    return codes[a] < codes[b];
+  });
+}
+
+void sort_by_morton_code(const Span<float> positions, MutableSpan<int> r_order)
+{
+  sort_by_morton_code_impl(positions, r_order);
+}
+
+void sort_by_morton_code(const Span<float2> positions, MutableSpan<int> r_order)
+{
+  sort_by_morton_code_impl(positions, r_order);
+}
+
+void sort_by_morton_code(const Span<float3> positions, MutableSpan<int> r_order)
+{
+  sort_by_morton_code_impl(positions, r_order);
+}
+
+void sort_by_morton_code(const Span<float4> positions, MutableSpan<int> r_order)
+{
+  sort_by_morton_code_impl(positions, r_order);
+}
+
+}  // namespace blender
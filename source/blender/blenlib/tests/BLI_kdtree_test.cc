@@ -0,0 +1,111 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_kdtree.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_rand.hh"
+
+namespace blender::tests {
+
+static Array<float3> random_positions(const int size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Array<float3> positions(size);
+  for (float3 &position : positions) {
+    position = float3(rng.get_float(), rng.get_float(), rng.get_float());
+  }
+  return positions;
+}
+
+static KDTree<float3> *build_tree(const Span<float3> positions)
+{
+  KDTree<float3> *tree = kdtree_new<float3>(positions.size());
+  for (const int i : positions.index_range()) {
+    kdtree_insert<float3>(tree, i, positions[i]);
+  }
+  kdtree_balance<float3>(tree);
+  return tree;
+}
+
+static int find_nearest_brute_force(const Span<float3> positions, const float3 &co)
+{
+  int nearest = -1;
+  float nearest_dist_sq = FLT_MAX;
+  for (const int i : positions.index_range()) {
+    const float dist_sq = math::distance_squared(positions[i], co);
+    if (dist_sq < nearest_dist_sq) {
+      nearest_dist_sq = dist_sq;
+      nearest = i;
+    }
+  }
+  return nearest;
+}
+
+TEST(kdtree, BalanceLarge)
+{
+  /* Large enough to be balanced on multiple threads. */
+  const Array<float3> positions = random_positions(50000, 0);
+  const Array<float3> queries = random_positions(100, 1);
+  KDTree<float3> *tree = build_tree(positions);
+  for (const float3 &query : queries) {
+    EXPECT_EQ(kdtree_find_nearest<float3>(tree, query, nullptr),
+              find_nearest_brute_force(positions, query));
+  }
+  kdtree_free<float3>(tree);
+}
+
+TEST(kdtree, FindNearestBatch)
+{
+  const Array<float3> positions = random_positions(20000, 2);
+  const Array<float3> queries = random_positions(5000, 3);
+  KDTree<float3> *tree = build_tree(positions);
+  const auto no_filter = [](const int /*query_i*/,
+                            const int /*index*/,
+                            const float3 & /*co*/,
+                            const float /*dist_sq*/) { return 1; };
+
+  Array<int> result(queries.size(), -2);
+  kdtree_find_nearest_batch_cb<float3>(tree, queries, queries.index_range(), result, no_filter);
+  for (const int i : queries.index_range()) {
+    EXPECT_EQ(result[i], kdtree_find_nearest<float3>(tree, queries[i], nullptr));
+  }
+
+  /* Queries that are not in the mask are skipped. */
+  IndexMaskMemory memory;
+  const IndexMask mask = IndexMask::from_predicate(
+      queries.index_range(), memory, [](const int64_t i) { return i % 3 == 0; });
+  Array<int> masked_result(queries.size(), -2);
+  kdtree_find_nearest_batch_cb<float3>(tree, queries, mask, masked_result, no_filter);
+  for (const int i : queries.index_range()) {
+    EXPECT_EQ(masked_result[i], i % 3 == 0 ? result[i] : -2);
+  }
+
+  /* Find the nearest neighbor of every point, ignoring the point itself. */
+  Array<int> neighbors(positions.size(), -2);
+  kdtree_find_nearest_batch_cb<float3>(
+      tree,
+      positions,
+      positions.index_range(),
+      neighbors,
+      [](const int query_i, const int index, const float3 & /*co*/, const float /*dist_sq*/) {
+        return query_i == index ? 0 : 1;
+      });
+  for (const int i : positions.index_range().take_front(500)) {
+    const int expected = kdtree_find_nearest_cb<float3>(
+        tree,
+        positions[i],
+        nullptr,
+        [&](const int index, const float3 & /*co*/, const float /*dist_sq*/) {
+          return i == index ? 0 : 1;
+        });
+    EXPECT_EQ(neighbors[i], expected);
+    EXPECT_NE(neighbors[i], i);
+  }
+  kdtree_free<float3>(tree);
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,47 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include <limits>
+
+#include "BLI_array.hh"
+#include "BLI_morton_code.hh"
+
+#include "testing/testing.h"
+
+#include "BLI_strict_flags.hh" /* IWYU pragma: keep. Keep last. */
+
+namespace blender::tests {
+
+TEST(morton_code, Bounds)
+{
+  const Array<float> positions = {3.0f, -1.0f, 1.0f};
+  Array<uint32_t> codes(positions.size());
+  calc_morton_codes(positions, codes);
+  EXPECT_EQ(codes[0], std::numeric_limits<uint32_t>::max());
+  EXPECT_EQ(codes[1], 0u);
+  EXPECT_EQ(codes[2], std::numeric_limits<uint32_t>::max() / 2);
+}
+
+TEST(morton_code, SortByCode)
+{
+  const Array<float3> positions = {{0.0f, 0.0f, 0.0f},
+                                   {1.0f, 1.0f, 1.0f},
+                                   {0.1f, 0.0f, 0.0f},
+                                   {0.9f, 1.0f, 1.0f},
+                                   {0.0f, 0.0f, 0.1f}};
+  Array<int> order(positions.size());
+  sort_by_morton_code(positions.as_span(), order);
+  EXPECT_EQ_SPAN<int>({0, 4, 2, 3, 1}, order);
+}
+
+TEST(morton_code, SameCoordinates)
+{
+  /* Axes without extent must not result in invalid codes. */
+  const Array<float2> positions = {{1.0f, 5.0f}, {0.0f, 5.0f}, {2.0f, 5.0f}};
+  Array<int> order(positions.size());
+  sort_by_morton_code(positions.as_span(), order);
+  EXPECT_EQ_SPAN<int>({1, 0, 2}, order);
+}
+
+}  // namespace blender::tests
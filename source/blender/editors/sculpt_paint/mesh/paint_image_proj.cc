@@ -225,8 +225,11 @@ struct ProjPaintImage {
   uint8_t *byte_data_mut = nullptr;
 
   ImagePaintPartialRedraw *partRedrawRect;
-  /** Only used to build undo tiles during painting. */
-  volatile const void **undoRect;
+  /**
+   * Only used to build undo tiles during painting. Entries are only accessed atomically, they are
+   * claimed with #TILE_PENDING by the thread that pushes the tile.
+   */
+  void **undoRect;
   /** The mask accumulation must happen on canvas, not on space screen bucket.
    * Here we store the mask rectangle. */
   ushort **maskRect;
@@ -413,7 +416,10 @@ struct ProjPaintState {
   int thread_tot;
   int bucketMin[2];
   int bucketMax[2];
-  /** must lock threads while accessing these. */
+  /**
+   * Index of the next bucket to paint within the #bucketMin and #bucketMax rectangle, incremented
+   * atomically by the threads painting the buckets.
+   */
   int context_bucket_index;
 
   CurveMapping *cavity_curve;
@@ -451,8 +457,6 @@ struct ProjPaintState {
   ListBaseT<VertSeam> *vertSeams;
 #endif
 
-  SpinLock *tile_lock;
-
   Mesh *mesh_eval;
   int totloop_eval;
   int faces_num_eval;
@@ -543,7 +547,6 @@ struct ProjPixelClone {
 
 /* undo tile pushing */
 struct TileInfo {
-  SpinLock *lock;
   bool masked;
   ushort tile_width;
   ProjPaintImage *pjima;
@@ -1882,25 +1885,16 @@ static int project_paint_undo_subtiles(const TileInfo *tinf, int tx, int ty)
 {
   ProjPaintImage *pjIma = tinf->pjima;
   int tile_index = tx + ty * tinf->tile_width;
-  bool generate_tile = false;
+  void **undo_rect = &pjIma->undoRect[tile_index];
 
-  /* double check lock to avoid locking */
-  if (!pjIma->undoRect[tile_index]) [[unlikely]] {
-    if (tinf->lock) {
-      BLI_spin_lock(tinf->lock);
-    }
-    if (!pjIma->undoRect[tile_index]) [[likely]] {
-      pjIma->undoRect[tile_index] = TILE_PENDING;
-      generate_tile = true;
+  /* Only the thread that replaces the null pointer with #TILE_PENDING pushes the tile, without
+   * locking. Other threads wait for the result in #project_paint_uvpixel_init. */
+  if (atomic_load_ptr(undo_rect) == nullptr) [[unlikely]] {
+    if (atomic_cas_ptr(undo_rect, nullptr, TILE_PENDING) != nullptr) {
+      return tile_index;
     }
-    if (tinf->lock) {
-      BLI_spin_unlock(tinf->lock);
-    }
-  }
-
-  if (generate_tile) {
     PaintTileMap *undo_tiles = ED_image_paint_tile_map_get();
-    volatile const void *undorect = nullptr;
+    const void *undorect = nullptr;
     if (tinf->masked) {
       if (const ImBuf *ibuf = ED_image_paint_tile_push(undo_tiles,
                                                        pjIma->ima,
@@ -1940,13 +1934,7 @@ static int project_paint_undo_subtiles(const TileInfo *tinf, int tx, int ty)
 
     IMB_mark_dirty(pjIma->ibuf);
     /* tile ready, publish */
-    if (tinf->lock) {
-      BLI_spin_lock(tinf->lock);
-    }
-    pjIma->undoRect[tile_index] = undorect;
-    if (tinf->lock) {
-      BLI_spin_unlock(tinf->lock);
-    }
+    atomic_store_ptr(undo_rect, const_cast<void *>(undorect));
   }
 
   return tile_index;
@@ -1995,7 +1983,7 @@ static ProjPixel *project_paint_uvpixel_init(const ProjPaintState *ps,
   tile_index = project_paint_undo_subtiles(tinf, x_tile, y_tile);
 
   /* other thread may be initializing the tile so wait here */
-  while (projima->undoRect[tile_index] == TILE_PENDING) {
+  while (atomic_load_ptr(&projima->undoRect[tile_index]) == TILE_PENDING) {
     /* pass */
   }
 
@@ -2007,14 +1995,12 @@ static ProjPixel *project_paint_uvpixel_init(const ProjPaintState *ps,
   projPixel->pixel_offset = (x_px + y_px * ibuf->x) * 4;
 
   if (ibuf->float_data()) {
-    projPixel->origColor.f_pt = static_cast<float *>(
-                                    const_cast<void *>(projima->undoRect[tile_index])) +
+    projPixel->origColor.f_pt = static_cast<float *>(projima->undoRect[tile_index]) +
                                 4 * tile_offset;
     zero_v4(projPixel->newColor.f);
   }
   else {
-    projPixel->origColor.uint_pt = static_cast<uint *>(
-                                       const_cast<void *>(projima->undoRect[tile_index])) +
+    projPixel->origColor.uint_pt = static_cast<uint *>(projima->undoRect[tile_index]) +
                                    tile_offset;
     projPixel->newColor.uint_ = 0;
   }
@@ -3090,7 +3076,6 @@ static void project_paint_face_init(const ProjPaintState *ps,
   bool threaded = (ps->thread_tot > 1);
 
   TileInfo tinf = {
-      ps->tile_lock,
       ps->do_masking,
       ushort(ED_IMAGE_UNDO_TILE_NUMBER(ibuf->x)),
       ps->projImages + image_index,
@@ -4056,13 +4041,6 @@ static void proj_paint_state_thread_init(ProjPaintState *ps, const bool reset_th
     ps->thread_tot = 1;
   }
 
-  if (ps->is_shared_user == false) {
-    if (ps->thread_tot > 1) {
-      ps->tile_lock = MEM_new_uninitialized<SpinLock>("projpaint_tile_lock");
-      BLI_spin_init(ps->tile_lock);
-    }
-  }
-
   for (int a = 0; a < ps->thread_tot; a++) {
     ps->arena_mt[a] = BLI_memarena_new(MEM_SIZE_OPTIMAL(1 << 16), "project paint arena");
   }
@@ -4459,8 +4437,8 @@ static void project_paint_build_proj_ima(ProjPaintState *ps,
     projIma->partRedrawRect = static_cast<ImagePaintPartialRedraw *>(
         BLI_memarena_alloc(arena, sizeof(ImagePaintPartialRedraw) * PROJ_BOUNDBOX_SQUARED));
     partial_redraw_array_init(projIma->partRedrawRect);
-    projIma->undoRect = static_cast<volatile const void **>(BLI_memarena_alloc(arena, size));
-    memset(static_cast<void *>(projIma->undoRect), 0, size);
+    projIma->undoRect = static_cast<void **>(BLI_memarena_alloc(arena, size));
+    memset(projIma->undoRect, 0, size);
     projIma->maskRect = static_cast<ushort **>(BLI_memarena_alloc(arena, size));
     memset(projIma->maskRect, 0, size);
     projIma->valid = static_cast<bool **>(BLI_memarena_alloc(arena, size));
@@ -4852,11 +4830,6 @@ static void project_paint_end(ProjPaintState *ps)
     if (ps->do_layer_clone) {
       MEM_delete(ps->poly_to_loop_uv_clone);
     }
-    if (ps->thread_tot > 1) {
-      BLI_spin_end(ps->tile_lock);
-      /* The void cast is needed when building without TBB. */
-      MEM_delete_void((void *)ps->tile_lock);
-    }
 
 #ifndef PROJ_DEBUG_NOSEAMBLEED
     if (ps->seam_bleed_px > 0.0f) {
@@ -4989,7 +4962,7 @@ static bool project_bucket_iter_init(ProjPaintState *ps, const float mval_f[2])
     ps->bucketMax[1] = ps->buckets_y;
   }
 
-  ps->context_bucket_index = ps->bucketMin[0] + ps->bucketMin[1] * ps->buckets_x;
+  ps->context_bucket_index = 0;
   return true;
 }
 
@@ -5000,26 +4973,26 @@ static bool project_bucket_iter_next(ProjPaintState *ps,
 {
   const int diameter = 2 * ps->brush_size;
 
-  const int max_bucket_idx = ps->bucketMax[0] + (ps->bucketMax[1] - 1) * ps->buckets_x;
+  /* Only iterate over the buckets inside the brush rectangle, so that threads don't have to skip
+   * the buckets outside of it in every row. */
+  const int rect_width = ps->bucketMax[0] - ps->bucketMin[0];
+  const int rect_num = rect_width * (ps->bucketMax[1] - ps->bucketMin[1]);
 
-  for (int bidx = atomic_fetch_and_add_int32(&ps->context_bucket_index, 1); bidx < max_bucket_idx;
-       bidx = atomic_fetch_and_add_int32(&ps->context_bucket_index, 1))
+  for (int i = atomic_fetch_and_add_int32(&ps->context_bucket_index, 1); i < rect_num;
+       i = atomic_fetch_and_add_int32(&ps->context_bucket_index, 1))
   {
-    const int bucket_y = bidx / ps->buckets_x;
-    const int bucket_x = bidx - (bucket_y * ps->buckets_x);
+    const int bucket_y = ps->bucketMin[1] + i / rect_width;
+    const int bucket_x = ps->bucketMin[0] + i % rect_width;
 
-    BLI_assert(bucket_y >= ps->bucketMin[1] && bucket_y < ps->bucketMax[1]);
-    if (bucket_x >= ps->bucketMin[0] && bucket_x < ps->bucketMax[0]) {
-      /* Use bucket_bounds for #project_bucket_isect_circle and #project_bucket_init. */
-      project_bucket_bounds(ps, bucket_x, bucket_y, bucket_bounds);
+    /* Use bucket_bounds for #project_bucket_isect_circle and #project_bucket_init. */
+    project_bucket_bounds(ps, bucket_x, bucket_y, bucket_bounds);
 
-      if ((ps->source != PROJ_SRC_VIEW) ||
-          project_bucket_isect_circle(mval, float(diameter * diameter), bucket_bounds))
-      {
-        *bucket_index = bidx;
+    if ((ps->source != PROJ_SRC_VIEW) ||
+        project_bucket_isect_circle(mval, float(diameter * diameter), bucket_bounds))
+    {
+      *bucket_index = bucket_x + bucket_y * ps->buckets_x;
 
-        return true;
-      }
+      return true;
     }
   }
 
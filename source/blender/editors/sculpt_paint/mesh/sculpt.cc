@@ -5048,6 +5048,12 @@ struct SculptPaintStroke final : public PaintStroke {
   /* Needed to tag other viewports */
   wmWindowManager *wm_;
 
+  /**
+   * The update type of dabs applied since the last redraw. Spacing can create many dabs for a
+   * single mouse event, tagging updates and redraws once for all of them is enough.
+   */
+  std::optional<UpdateType> pending_update_;
+
   SculptPaintStroke(bContext *C, wmOperator *op, const wmEvent *event) : PaintStroke(C, op, event)
   {
     bmain_ = CTX_data_main(C);
@@ -5955,20 +5961,20 @@ void SculptPaintStroke::update_step(wmOperator * /*op*/, PointerRNA *itemptr)
   ss.cache->first_time = false;
   copy_v3_v3(ss.cache->last_location, ss.cache->location);
 
-  /* Cleanup. */
+  /* Cleanup. The update itself is flushed in #redraw. */
   if (brush.sculpt_brush_type == SCULPT_BRUSH_TYPE_MASK) {
-    flush_update_step(this->vc, *this->object, UpdateType::Mask);
+    pending_update_ = UpdateType::Mask;
   }
   else if (brush_type_is_paint(brush.sculpt_brush_type)) {
     if (SCULPT_use_image_paint_brush(*this->paint_mode_settings_, ob)) {
-      flush_update_step(this->vc, *this->object, UpdateType::Image);
+      pending_update_ = UpdateType::Image;
     }
     else {
-      flush_update_step(this->vc, *this->object, UpdateType::Color);
+      pending_update_ = UpdateType::Color;
     }
   }
   else {
-    flush_update_step(this->vc, *this->object, UpdateType::Position);
+    pending_update_ = UpdateType::Position;
   }
 }
 
@@ -6038,7 +6044,14 @@ void SculptPaintStroke::done(bool is_cancel, bool stroke_started)
   brush_exit_tex(sd);
 }
 
-void SculptPaintStroke::redraw(bool /*final*/) {}
+void SculptPaintStroke::redraw(bool /*final*/)
+{
+  if (!pending_update_) {
+    return;
+  }
+  flush_update_step(this->vc, *this->object, *pending_update_);
+  pending_update_.reset();
+}
 
 bool SculptPaintStroke::test_cancel()
 {
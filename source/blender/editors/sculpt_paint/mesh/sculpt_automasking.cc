@@ -7,6 +7,7 @@
  */
 
 #include "BLI_array.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_index_range.hh"
 #include "BLI_math_base.hh"
 #include "BLI_math_base_c.hh"
@@ -1344,14 +1345,40 @@ enum class BoundaryAutomaskMode {
   FaceSets = 2,
 };
 
-static void init_boundary_masking_mesh(Object &object,
-                                       const Depsgraph &depsgraph,
-                                       const BoundaryAutomaskMode mode,
-                                       const int propagation_steps,
-                                       MutableSpan<float> factors)
+/**
+ * Propagate the distance from the vertices with a distance of zero to their neighbors, one ring
+ * per step. The vertices reached in each step are found in parallel before any of them is
+ * assigned, which gives the same result as propagating in order.
+ */
+template<typename Fn>
+static void propagate_boundary_distances(const int propagation_steps,
+                                         MutableSpan<int> edge_distance,
+                                         const Fn &has_neighbor_with_distance)
 {
-  SculptSession &ss = *object.runtime->sculpt_session;
-  Mesh &mesh = *id_cast<Mesh *>(object.data);
+  IndexMaskMemory memory;
+  IndexMask unreached = IndexMask::from_predicate(
+      edge_distance.index_range(), memory, [&](const int64_t i) {
+        return edge_distance[i] == EDGE_DISTANCE_INF;
+      });
+  for (const int propagation_it : IndexRange(propagation_steps)) {
+    const IndexMask reached = IndexMask::from_predicate(unreached, memory, [&](const int64_t i) {
+      return has_neighbor_with_distance(int(i), propagation_it);
+    });
+    if (reached.is_empty()) {
+      break;
+    }
+    index_mask::masked_fill(edge_distance, propagation_it + 1, reached);
+    unreached = IndexMask::from_difference(unreached, reached, memory);
+  }
+}
+
+static Array<int> calc_boundary_distances_mesh(const Object &object,
+                                               const Depsgraph &depsgraph,
+                                               const BoundaryAutomaskMode mode,
+                                               const int propagation_steps)
+{
+  const SculptSession &ss = *object.runtime->sculpt_session;
+  const Mesh &mesh = *id_cast<const Mesh *>(object.data);
 
   const OffsetIndices faces = mesh.faces();
   const Span<int> corner_verts = mesh.corner_verts();
@@ -1361,62 +1388,47 @@ static void init_boundary_masking_mesh(Object &object,
   const VArraySpan face_sets = *attributes.lookup<int>(".sculpt_face_set", bke::AttrDomain::Face);
 
   const int num_verts = bke::pbvh::vert_positions_eval(depsgraph, object).size();
-  Array<int> edge_distance(num_verts, EDGE_DISTANCE_INF);
-
-  for (const int i : IndexRange(num_verts)) {
-    switch (mode) {
-      case BoundaryAutomaskMode::Edges:
-        if (boundary::vert_is_boundary(
-                vert_to_face_map, hide_poly, ss.boundary_info_cache->verts, i))
-        {
-          edge_distance[i] = 0;
-        }
-        break;
-      case BoundaryAutomaskMode::FaceSets:
-        if (!face_set::vert_has_unique_face_set(vert_to_face_map, face_sets, i)) {
-          edge_distance[i] = 0;
-        }
-        break;
-    }
-  }
-
-  Vector<int> neighbors;
-  for (const int propagation_it : IndexRange(propagation_steps)) {
-    for (const int i : IndexRange(num_verts)) {
-      if (edge_distance[i] != EDGE_DISTANCE_INF) {
-        continue;
-      }
-
-      for (const int neighbor :
-           vert_neighbors_get_mesh(faces, corner_verts, vert_to_face_map, hide_poly, i, neighbors))
-      {
-        if (edge_distance[neighbor] == propagation_it) {
-          edge_distance[i] = propagation_it + 1;
-        }
+  Array<int> edge_distance(num_verts);
+
+  threading::parallel_for(IndexRange(num_verts), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      bool is_boundary = false;
+      switch (mode) {
+        case BoundaryAutomaskMode::Edges:
+          is_boundary = boundary::vert_is_boundary(
+              vert_to_face_map, hide_poly, ss.boundary_info_cache->verts, i);
+          break;
+        case BoundaryAutomaskMode::FaceSets:
+          is_boundary = !face_set::vert_has_unique_face_set(vert_to_face_map, face_sets, i);
+          break;
       }
+      edge_distance[i] = is_boundary ? 0 : EDGE_DISTANCE_INF;
     }
-  }
+  });
 
-  for (const int i : IndexRange(num_verts)) {
-    if (edge_distance[i] == EDGE_DISTANCE_INF) {
-      continue;
-    }
-
-    const float p = 1.0f - (float(edge_distance[i]) / float(propagation_steps));
-    const float edge_boundary_automask = pow2f(p);
+  propagate_boundary_distances(
+      propagation_steps, edge_distance, [&](const int vert, const int distance) {
+        Vector<int> neighbors;
+        for (const int neighbor : vert_neighbors_get_mesh(
+                 faces, corner_verts, vert_to_face_map, hide_poly, vert, neighbors))
+        {
+          if (edge_distance[neighbor] == distance) {
+            return true;
+          }
+        }
+        return false;
+      });
 
-    factors[i] *= (1.0f - edge_boundary_automask);
-  }
+  return edge_distance;
 }
 
-static void init_boundary_masking_grids(Object &object,
-                                        const BoundaryAutomaskMode mode,
-                                        const int propagation_steps,
-                                        MutableSpan<float> factors)
+static Array<int> calc_boundary_distances_grids(const Object &object,
+                                                const BoundaryAutomaskMode mode,
+                                                const int propagation_steps)
 {
-  SculptSession &ss = *object.runtime->sculpt_session;
+  const SculptSession &ss = *object.runtime->sculpt_session;
   const SubdivCCG &subdiv_ccg = *ss.subdiv_ccg;
-  Mesh &mesh = *id_cast<Mesh *>(object.data);
+  const Mesh &mesh = *id_cast<const Mesh *>(object.data);
 
   const Span<float3> positions = subdiv_ccg.positions;
   const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
@@ -1427,118 +1439,123 @@ static void init_boundary_masking_grids(Object &object,
   const bke::AttributeAccessor attributes = mesh.attributes();
   const VArraySpan face_sets = *attributes.lookup<int>(".sculpt_face_set", bke::AttrDomain::Face);
 
-  Array<int> edge_distance(positions.size(), EDGE_DISTANCE_INF);
-  for (const int i : positions.index_range()) {
-    const SubdivCCGCoord coord = SubdivCCGCoord::from_index(key, i);
-    switch (mode) {
-      case BoundaryAutomaskMode::Edges:
-        if (boundary::vert_is_boundary(faces,
-                                       corner_verts,
-                                       ss.boundary_info_cache->verts,
-                                       ss.boundary_info_cache->edges,
-                                       subdiv_ccg,
-                                       coord))
-        {
-          edge_distance[i] = 0;
-        }
-        break;
-      case BoundaryAutomaskMode::FaceSets:
-        if (!face_set::vert_has_unique_face_set(
-                faces, corner_verts, vert_to_face_map, face_sets, subdiv_ccg, coord))
-        {
-          edge_distance[i] = 0;
-        }
-        break;
-    }
-  }
-
-  SubdivCCGNeighbors neighbors;
-  for (const int propagation_it : IndexRange(propagation_steps)) {
-    for (const int i : positions.index_range()) {
-      if (edge_distance[i] != EDGE_DISTANCE_INF) {
-        continue;
-      }
-
+  Array<int> edge_distance(positions.size());
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
       const SubdivCCGCoord coord = SubdivCCGCoord::from_index(key, i);
-
-      BKE_subdiv_ccg_neighbor_coords_get(subdiv_ccg, coord, false, neighbors);
-      for (const SubdivCCGCoord neighbor : neighbors.coords) {
-        const int neighbor_idx = neighbor.to_index(key);
-        if (edge_distance[neighbor_idx] == propagation_it) {
-          edge_distance[i] = propagation_it + 1;
-        }
+      bool is_boundary = false;
+      switch (mode) {
+        case BoundaryAutomaskMode::Edges:
+          is_boundary = boundary::vert_is_boundary(faces,
+                                                   corner_verts,
+                                                   ss.boundary_info_cache->verts,
+                                                   ss.boundary_info_cache->edges,
+                                                   subdiv_ccg,
+                                                   coord);
+          break;
+        case BoundaryAutomaskMode::FaceSets:
+          is_boundary = !face_set::vert_has_unique_face_set(
+              faces, corner_verts, vert_to_face_map, face_sets, subdiv_ccg, coord);
+          break;
       }
+      edge_distance[i] = is_boundary ? 0 : EDGE_DISTANCE_INF;
     }
-  }
-
-  for (const int i : positions.index_range()) {
-    if (edge_distance[i] == EDGE_DISTANCE_INF) {
-      continue;
-    }
-
-    const float p = 1.0f - (float(edge_distance[i]) / float(propagation_steps));
-    const float edge_boundary_automask = pow2f(p);
+  });
+
+  propagate_boundary_distances(
+      propagation_steps, edge_distance, [&](const int vert, const int distance) {
+        SubdivCCGNeighbors neighbors;
+        BKE_subdiv_ccg_neighbor_coords_get(
+            subdiv_ccg, SubdivCCGCoord::from_index(key, vert), false, neighbors);
+        for (const SubdivCCGCoord neighbor : neighbors.coords) {
+          if (edge_distance[neighbor.to_index(key)] == distance) {
+            return true;
+          }
+        }
+        return false;
+      });
 
-    factors[i] *= (1.0f - edge_boundary_automask);
-  }
+  return edge_distance;
 }
 
-static void init_boundary_masking_bmesh(Object &object,
-                                        const BoundaryAutomaskMode mode,
-                                        const int propagation_steps,
-                                        MutableSpan<float> factors)
+static Array<int> calc_boundary_distances_bmesh(const Object &object,
+                                                const BoundaryAutomaskMode mode,
+                                                const int propagation_steps)
 {
-  SculptSession &ss = *object.runtime->sculpt_session;
+  const SculptSession &ss = *object.runtime->sculpt_session;
   BMesh &bm = *ss.bm;
   const int face_set_offset = CustomData_get_offset_named(
       &bm.pdata, CD_PROP_INT32, ".sculpt_face_set");
   const int num_verts = BM_mesh_elem_count(&bm, BM_VERT);
 
-  Array<int> edge_distance(num_verts, EDGE_DISTANCE_INF);
+  Array<int> edge_distance(num_verts);
+  threading::parallel_for(IndexRange(num_verts), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMVert *vert = BM_vert_at_index(&bm, i);
+      bool is_boundary = false;
+      switch (mode) {
+        case BoundaryAutomaskMode::Edges:
+          is_boundary = boundary::vert_is_boundary(vert);
+          break;
+        case BoundaryAutomaskMode::FaceSets:
+          is_boundary = !face_set::vert_has_unique_face_set(face_set_offset, *vert);
+          break;
+      }
+      edge_distance[i] = is_boundary ? 0 : EDGE_DISTANCE_INF;
+    }
+  });
 
-  for (const int i : IndexRange(num_verts)) {
-    BMVert *vert = BM_vert_at_index(&bm, i);
-    switch (mode) {
-      case BoundaryAutomaskMode::Edges:
-        if (boundary::vert_is_boundary(vert)) {
-          edge_distance[i] = 0;
-        }
-        break;
-      case BoundaryAutomaskMode::FaceSets:
-        if (!face_set::vert_has_unique_face_set(face_set_offset, *vert)) {
-          edge_distance[i] = 0;
+  propagate_boundary_distances(
+      propagation_steps, edge_distance, [&](const int vert, const int distance) {
+        BMeshNeighborVerts neighbors;
+        for (BMVert *neighbor : vert_neighbors_get_bmesh(*BM_vert_at_index(&bm, vert), neighbors))
+        {
+          if (edge_distance[BM_elem_index_get(neighbor)] == distance) {
+            return true;
+          }
         }
-    }
-  }
+        return false;
+      });
 
-  BMeshNeighborVerts neighbors;
-  for (const int propagation_it : IndexRange(propagation_steps)) {
-    for (const int i : IndexRange(num_verts)) {
-      if (edge_distance[i] != EDGE_DISTANCE_INF) {
+  return edge_distance;
+}
+
+static void apply_boundary_distances(const Span<int> edge_distance,
+                                     const int propagation_steps,
+                                     MutableSpan<float> factors)
+{
+  threading::parallel_for(edge_distance.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (edge_distance[i] == EDGE_DISTANCE_INF) {
         continue;
       }
 
-      BMVert *vert = BM_vert_at_index(&bm, i);
-      for (BMVert *neighbor : vert_neighbors_get_bmesh(*vert, neighbors)) {
-        const int neighbor_idx = BM_elem_index_get(neighbor);
+      const float p = 1.0f - (float(edge_distance[i]) / float(propagation_steps));
+      const float edge_boundary_automask = pow2f(p);
 
-        if (edge_distance[neighbor_idx] == propagation_it) {
-          edge_distance[i] = propagation_it + 1;
-        }
-      }
-    }
-  }
-
-  for (const int i : IndexRange(num_verts)) {
-    if (edge_distance[i] == EDGE_DISTANCE_INF) {
-      continue;
+      factors[i] *= (1.0f - edge_boundary_automask);
     }
+  });
+}
 
-    const float p = 1.0f - (float(edge_distance[i]) / float(propagation_steps));
-    const float edge_boundary_automask = pow2f(p);
-
-    factors[i] *= (1.0f - edge_boundary_automask);
+static bool boundary_cache_is_valid(const SculptBoundaryAutomaskCache &cache,
+                                    const bke::pbvh::Tree &pbvh,
+                                    const BoundaryAutomaskMode mode,
+                                    const int propagation_steps,
+                                    const int verts_num)
+{
+  if (cache.propagation_steps != propagation_steps || cache.edge_distance.size() != verts_num) {
+    return false;
+  }
+  if (cache.visibility_version != pbvh.visibility_version()) {
+    return false;
   }
+  if (mode == BoundaryAutomaskMode::FaceSets &&
+      cache.face_sets_version != pbvh.face_sets_version())
+  {
+    return false;
+  }
+  return true;
 }
 
 static void init_boundary_masking(Object &object,
@@ -1548,17 +1565,40 @@ static void init_boundary_masking(Object &object,
                                   MutableSpan<float> factors)
 {
   PRF_scope(ProfileCategory::Editor);
-  switch (bke::object::pbvh_get(object)->type()) {
-    case bke::pbvh::Type::Mesh:
-      init_boundary_masking_mesh(object, depsgraph, mode, propagation_steps, factors);
-      break;
-    case bke::pbvh::Type::Grids:
-      init_boundary_masking_grids(object, mode, propagation_steps, factors);
-      break;
-    case bke::pbvh::Type::BMesh:
-      init_boundary_masking_bmesh(object, mode, propagation_steps, factors);
-      break;
+  SculptSession &ss = *object.runtime->sculpt_session;
+  const bke::pbvh::Tree &pbvh = *bke::object::pbvh_get(object);
+  if (pbvh.type() == bke::pbvh::Type::BMesh) {
+    /* Vertex indices change with dynamic topology, so the distances can't be reused. */
+    const Array<int> edge_distance = calc_boundary_distances_bmesh(
+        object, mode, propagation_steps);
+    apply_boundary_distances(edge_distance, propagation_steps, factors);
+    return;
+  }
+
+  /* The distances only depend on topology, visibility and face sets, so they are kept between
+   * strokes. Changing topology rebuilds the BVH tree, which frees the cache. */
+  std::unique_ptr<SculptBoundaryAutomaskCache> &cache = mode == BoundaryAutomaskMode::Edges ?
+                                                            ss.boundary_edges_automask_cache :
+                                                            ss.boundary_face_sets_automask_cache;
+  if (!cache || !boundary_cache_is_valid(*cache, pbvh, mode, propagation_steps, factors.size())) {
+    cache = std::make_unique<SculptBoundaryAutomaskCache>();
+    cache->face_sets_version = pbvh.face_sets_version();
+    cache->visibility_version = pbvh.visibility_version();
+    cache->propagation_steps = propagation_steps;
+    switch (pbvh.type()) {
+      case bke::pbvh::Type::Mesh:
+        cache->edge_distance = calc_boundary_distances_mesh(
+            object, depsgraph, mode, propagation_steps);
+        break;
+      case bke::pbvh::Type::Grids:
+        cache->edge_distance = calc_boundary_distances_grids(object, mode, propagation_steps);
+        break;
+      case bke::pbvh::Type::BMesh:
+        BLI_assert_unreachable();
+        break;
+    }
   }
+  apply_boundary_distances(cache->edge_distance, propagation_steps, factors);
 }
 
 /* Updates the cached values, preferring brush settings over tool-level settings. */
@@ -11,12 +11,14 @@
 
 #include "BLI_array_utils.hh"
 #include "BLI_enumerable_thread_specific.hh"
+#include "BLI_math_bits.hh"
 #include "BLI_math_geom_c.hh"
 #include "BLI_math_matrix.hh"
 #include "BLI_math_matrix_c.hh"
 #include "BLI_math_rotation_c.hh"
 #include "BLI_math_vector.hh"
 #include "BLI_ordered_edge.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.hh"
 #include "BLI_vector.hh"
 
@@ -1359,6 +1361,99 @@ static void calc_constraint_factors(const Depsgraph &depsgraph,
   }
 }
 
+/**
+ * Greedily assign a color to constraints that were added since the last step, the first color
+ * that isn't used by any other constraint of the affected vertices.
+ */
+static void update_constraint_colors(SimulationData &cloth_sim)
+{
+  const Span<LengthConstraint> constraints = cloth_sim.length_constraints;
+  if (cloth_sim.colored_constraints_num == constraints.size()) {
+    return;
+  }
+  if (cloth_sim.vert_constraint_colors.is_empty()) {
+    cloth_sim.vert_constraint_colors = Array<uint64_t>(cloth_sim.pos.size(), 0);
+  }
+  MutableSpan<uint64_t> vert_colors = cloth_sim.vert_constraint_colors;
+  const IndexRange new_constraints = constraints.index_range().drop_front(
+      cloth_sim.colored_constraints_num);
+  for (const int i : new_constraints) {
+    const int v1 = constraints[i].elem_index_a;
+    const int v2 = constraints[i].elem_index_b;
+    const uint64_t used_colors = vert_colors[v1] | vert_colors[v2];
+    if (used_colors == std::numeric_limits<uint64_t>::max()) {
+      cloth_sim.uncolored_constraints.append(i);
+      continue;
+    }
+    const int color = bitscan_forward_uint64(~used_colors);
+    vert_colors[v1] |= uint64_t(1) << color;
+    vert_colors[v2] |= uint64_t(1) << color;
+    if (color >= cloth_sim.constraint_colors.size()) {
+      cloth_sim.constraint_colors.resize(color + 1);
+    }
+    cloth_sim.constraint_colors[color].append(i);
+  }
+  cloth_sim.colored_constraints_num = constraints.size();
+}
+
+static void satisfy_constraint(const Brush *brush,
+                               const Span<float> factors,
+                               const LengthConstraint &constraint,
+                               SimulationData &cloth_sim)
+{
+  if (cloth_sim.node_state[constraint.node] != SCULPT_CLOTH_NODE_ACTIVE) {
+    /* Skip all constraints that were created for inactive nodes. */
+    return;
+  }
+
+  const int v1 = constraint.elem_index_a;
+  const int v2 = constraint.elem_index_b;
+
+  const float3 v1_to_v2 = float3(constraint.elem_position_b) - float3(constraint.elem_position_a);
+  const float current_distance = math::length(v1_to_v2);
+  float3 correction_vector;
+
+  const float constraint_distance = constraint.length +
+                                    (cloth_sim.length_constraint_tweak[v1] * 0.5f) +
+                                    (cloth_sim.length_constraint_tweak[v2] * 0.5f);
+
+  if (current_distance > 0.0f) {
+    correction_vector = v1_to_v2 * CLOTH_SOLVER_DISPLACEMENT_FACTOR *
+                        (1.0f - (constraint_distance / current_distance));
+  }
+  else {
+    correction_vector = v1_to_v2 * CLOTH_SOLVER_DISPLACEMENT_FACTOR;
+  }
+
+  const float3 correction_vector_half = correction_vector * 0.5f;
+
+  const float factor_v1 = factors[v1];
+  const float factor_v2 = factors[v2];
+
+  float deformation_strength = 1.0f;
+  if (constraint.type == SCULPT_CLOTH_CONSTRAINT_DEFORMATION) {
+    deformation_strength = (cloth_sim.deformation_strength[v1] +
+                            cloth_sim.deformation_strength[v2]) *
+                           0.5f;
+  }
+
+  if (constraint.type == SCULPT_CLOTH_CONSTRAINT_SOFTBODY) {
+    const float softbody_plasticity = brush ? brush->cloth_constraint_softbody_strength : 0.0f;
+    cloth_sim.pos[v1] += correction_vector_half *
+                         (1.0f * factor_v1 * constraint.strength * softbody_plasticity);
+    cloth_sim.softbody_pos[v1] += correction_vector_half * -1.0f * factor_v1 *
+                                  constraint.strength * (1.0f - softbody_plasticity);
+  }
+  else {
+    cloth_sim.pos[v1] += correction_vector_half * 1.0f * factor_v1 * constraint.strength *
+                         deformation_strength;
+    if (v1 != v2) {
+      cloth_sim.pos[v2] += correction_vector_half * -1.0f * factor_v2 * constraint.strength *
+                           deformation_strength;
+    }
+  }
+}
+
 static void cloth_brush_satisfy_constraints(const Depsgraph &depsgraph,
                                             const Object &object,
                                             const Brush *brush,
@@ -1373,60 +1468,19 @@ static void cloth_brush_satisfy_constraints(const Depsgraph &depsgraph,
   Array<float> factors(vertex_count_get(object));
   calc_constraint_factors(depsgraph, object, brush, sim_location, cloth_sim.init_pos, factors);
 
-  for (int constraint_it = 0; constraint_it < CLOTH_SIMULATION_ITERATIONS; constraint_it++) {
-    for (const LengthConstraint &constraint : cloth_sim.length_constraints) {
-      if (cloth_sim.node_state[constraint.node] != SCULPT_CLOTH_NODE_ACTIVE) {
-        /* Skip all constraints that were created for inactive nodes. */
-        continue;
-      }
-
-      const int v1 = constraint.elem_index_a;
-      const int v2 = constraint.elem_index_b;
-
-      const float3 v1_to_v2 = float3(constraint.elem_position_b) -
-                              float3(constraint.elem_position_a);
-      const float current_distance = math::length(v1_to_v2);
-      float3 correction_vector;
+  update_constraint_colors(cloth_sim);
+  const Span<LengthConstraint> constraints = cloth_sim.length_constraints;
 
-      const float constraint_distance = constraint.length +
-                                        (cloth_sim.length_constraint_tweak[v1] * 0.5f) +
-                                        (cloth_sim.length_constraint_tweak[v2] * 0.5f);
-
-      if (current_distance > 0.0f) {
-        correction_vector = v1_to_v2 * CLOTH_SOLVER_DISPLACEMENT_FACTOR *
-                            (1.0f - (constraint_distance / current_distance));
-      }
-      else {
-        correction_vector = v1_to_v2 * CLOTH_SOLVER_DISPLACEMENT_FACTOR;
-      }
-
-      const float3 correction_vector_half = correction_vector * 0.5f;
-
-      const float factor_v1 = factors[v1];
-      const float factor_v2 = factors[v2];
-
-      float deformation_strength = 1.0f;
-      if (constraint.type == SCULPT_CLOTH_CONSTRAINT_DEFORMATION) {
-        deformation_strength = (cloth_sim.deformation_strength[v1] +
-                                cloth_sim.deformation_strength[v2]) *
-                               0.5f;
-      }
-
-      if (constraint.type == SCULPT_CLOTH_CONSTRAINT_SOFTBODY) {
-        const float softbody_plasticity = brush ? brush->cloth_constraint_softbody_strength : 0.0f;
-        cloth_sim.pos[v1] += correction_vector_half *
-                             (1.0f * factor_v1 * constraint.strength * softbody_plasticity);
-        cloth_sim.softbody_pos[v1] += correction_vector_half * -1.0f * factor_v1 *
-                                      constraint.strength * (1.0f - softbody_plasticity);
-      }
-      else {
-        cloth_sim.pos[v1] += correction_vector_half * 1.0f * factor_v1 * constraint.strength *
-                             deformation_strength;
-        if (v1 != v2) {
-          cloth_sim.pos[v2] += correction_vector_half * -1.0f * factor_v2 * constraint.strength *
-                               deformation_strength;
+  for (int constraint_it = 0; constraint_it < CLOTH_SIMULATION_ITERATIONS; constraint_it++) {
+    for (const Span<int> color : cloth_sim.constraint_colors) {
+      threading::parallel_for(color.index_range(), 1024, [&](const IndexRange range) {
+        for (const int i : color.slice(range)) {
+          satisfy_constraint(brush, factors, constraints[i], cloth_sim);
         }
-      }
+      });
+    }
+    for (const int i : cloth_sim.uncolored_constraints) {
+      satisfy_constraint(brush, factors, constraints[i], cloth_sim);
     }
   }
 }
@@ -79,6 +79,18 @@ struct SimulationData {
   Vector<LengthConstraint> length_constraints;
   Array<float> length_constraint_tweak;
 
+  /**
+   * Indices of #length_constraints grouped by color. Constraints of the same color never affect
+   * the same vertex, so they can be solved in parallel. New constraints are colored before the
+   * next solver step.
+   */
+  Vector<Vector<int>> constraint_colors;
+  /** Constraints that couldn't be given a color. They are solved on a single thread. */
+  Vector<int> uncolored_constraints;
+  /** For every vertex, a bit for every color that is used by a constraint affecting it. */
+  Array<uint64_t> vert_constraint_colors;
+  int colored_constraints_num = 0;
+
   /* Position anchors for deformation brushes. These positions are modified by the brush and the
    * final positions of the simulated vertices are updated with constraints that use these points
    * as targets. */
@@ -838,9 +838,6 @@ static Array<float> geodesic_falloff_create(const Depsgraph &depsgraph,
         edges, mesh.verts_num, ss.vert_to_edge_offsets, ss.vert_to_edge_indices);
   }
 
-  Set<int> verts;
-  initial_verts.foreach_index([&](const int vert) { verts.add(vert); });
-
   return geodesic::distances_create(vert_positions,
                                     edges,
                                     faces,
@@ -848,7 +845,7 @@ static Array<float> geodesic_falloff_create(const Depsgraph &depsgraph,
                                     ss.vert_to_edge_map,
                                     ss.edge_to_face_map,
                                     hide_poly,
-                                    verts,
+                                    initial_verts,
                                     FLT_MAX);
 }
 static Array<float> geodesic_falloff_create(const Depsgraph &depsgraph,
@@ -2113,9 +2110,13 @@ static void update_for_vert(bContext *C, Object &ob, const std::optional<int> ve
               exec_mode::grain_size(1));
 
           IndexMaskMemory memory;
-          pbvh.tag_masks_changed(IndexMask::from_bools(node_changed, memory));
+          const IndexMask changed_nodes = IndexMask::from_bools(node_changed, memory);
+          pbvh.tag_masks_changed(changed_nodes);
 
-          BKE_subdiv_ccg_average_grids(*ss.subdiv_ccg);
+          BKE_subdiv_ccg_average_stitch_faces(
+              *ss.subdiv_ccg,
+              bke::pbvh::nodes_to_face_selection_grids(
+                  *ss.subdiv_ccg, nodes, changed_nodes, memory));
           break;
         }
         case bke::pbvh::Type::BMesh: {
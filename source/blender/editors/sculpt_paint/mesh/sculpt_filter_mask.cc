@@ -374,10 +374,13 @@ static void apply_new_mask_grids(const Depsgraph &depsgraph,
       exec_mode::grain_size(1));
 
   IndexMaskMemory memory;
-  pbvh.tag_masks_changed(IndexMask::from_bools(node_changed, memory));
+  const IndexMask changed_nodes = IndexMask::from_bools(node_changed, memory);
+  pbvh.tag_masks_changed(changed_nodes);
 
   /* New mask values need propagation across grid boundaries. */
-  BKE_subdiv_ccg_average_grids(subdiv_ccg);
+  BKE_subdiv_ccg_average_stitch_faces(
+      subdiv_ccg,
+      bke::pbvh::nodes_to_face_selection_grids(subdiv_ccg, nodes, changed_nodes, memory));
 }
 
 static void smooth_mask_grids(const SubdivCCG &subdiv_ccg,
@@ -9,9 +9,11 @@
 #include <cstdlib>
 
 #include "BLI_bit_vector.hh"
-#include "BLI_linklist_stack.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_math_geom_c.hh"
+#include "BLI_math_vector.hh"
 #include "BLI_math_vector_c.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -27,9 +29,9 @@ static bool sculpt_geodesic_mesh_test_dist_add(Span<float3> vert_positions,
                                                const int v1,
                                                const int v2,
                                                MutableSpan<float> dists,
-                                               const Set<int> &initial_verts)
+                                               const BoundedBitSpan initial_verts)
 {
-  if (initial_verts.contains(v0)) {
+  if (initial_verts[v0]) {
     return false;
   }
 
@@ -68,29 +70,17 @@ Array<float> distances_create(const Span<float3> vert_positions,
                               const GroupedSpan<int> vert_to_edge_map,
                               const GroupedSpan<int> edge_to_face_map,
                               const Span<bool> hide_poly,
-                              const Set<int> &initial_verts,
+                              const IndexMask &initial_verts,
                               const float limit_radius)
 {
   const float limit_radius_sq = limit_radius * limit_radius;
 
-  Array<float> dists(vert_positions.size());
+  Array<float> dists(vert_positions.size(), FLT_MAX);
   BitVector<> edge_tag(edges.size());
 
-  /* Both contain edge indices encoded as *void. */
-  BLI_LINKSTACK_DECLARE(queue, void *);
-  BLI_LINKSTACK_DECLARE(queue_next, void *);
-
-  BLI_LINKSTACK_INIT(queue);
-  BLI_LINKSTACK_INIT(queue_next);
-
-  for (const int i : vert_positions.index_range()) {
-    if (initial_verts.contains(i)) {
-      dists[i] = 0.0f;
-    }
-    else {
-      dists[i] = FLT_MAX;
-    }
-  }
+  BitVector<> initial_vert(vert_positions.size());
+  initial_verts.to_bits(initial_vert);
+  index_mask::masked_fill(dists.as_mutable_span(), 0.0f, initial_verts);
 
   /* Masks vertices that are further than limit radius from an initial vertex. As there is no need
    * to define a distance to them the algorithm can stop earlier by skipping them. */
@@ -105,31 +95,39 @@ Array<float> distances_create(const Span<float3> vert_positions,
     /* This is an O(n^2) loop used to limit the geodesic distance calculation to a radius. When
      * this optimization is needed, it is expected for the tool to request the distance to a low
      * number of vertices (usually just 1 or 2). */
-    for (const int v : initial_verts) {
-      const float *v_co = vert_positions[v];
-      for (const int i : vert_positions.index_range()) {
-        if (len_squared_v3v3(v_co, vert_positions[i]) <= limit_radius_sq) {
-          affected_vert[i].set();
-        }
-      }
-    }
+    IndexMaskMemory memory;
+    const IndexMask verts_in_radius = IndexMask::from_predicate(
+        vert_positions.index_range(), memory, [&](const int i) {
+          bool in_radius = false;
+          initial_verts.foreach_index([&](const int v) {
+            if (math::distance_squared(vert_positions[v], vert_positions[i]) <= limit_radius_sq) {
+              in_radius = true;
+            }
+          });
+          return in_radius;
+        });
+    verts_in_radius.to_bits(affected_vert);
   }
 
-  /* Add edges adjacent to an initial vertex to the queue. */
-  for (const int i : edges.index_range()) {
-    const int v1 = edges[i][0];
-    const int v2 = edges[i][1];
-    if (!affected_vert[v1] && !affected_vert[v2]) {
-      continue;
-    }
-    if (dists[v1] != FLT_MAX || dists[v2] != FLT_MAX) {
-      BLI_LINKSTACK_PUSH(queue, POINTER_FROM_INT(i));
-    }
-  }
+  /* Add edges adjacent to an initial vertex to the queue. The queues are used as stacks, the
+   * last added edge is processed first. */
+  IndexMaskMemory memory;
+  const IndexMask initial_edges = IndexMask::from_predicate(
+      edges.index_range(), memory, [&](const int i) {
+        const int v1 = edges[i][0];
+        const int v2 = edges[i][1];
+        if (!affected_vert[v1] && !affected_vert[v2]) {
+          return false;
+        }
+        return dists[v1] != FLT_MAX || dists[v2] != FLT_MAX;
+      });
+  Vector<int> queue(initial_edges.size());
+  initial_edges.to_indices(queue.as_mutable_span());
+  Vector<int> queue_next;
 
   do {
-    while (BLI_LINKSTACK_SIZE(queue)) {
-      const int e = POINTER_AS_INT(BLI_LINKSTACK_POP(queue));
+    while (!queue.is_empty()) {
+      const int e = queue.pop_last();
       int v1 = edges[e][0];
       int v2 = edges[e][1];
 
@@ -138,7 +136,7 @@ Array<float> distances_create(const Span<float3> vert_positions,
           std::swap(v1, v2);
         }
         sculpt_geodesic_mesh_test_dist_add(
-            vert_positions, v2, v1, SCULPT_GEODESIC_VERTEX_NONE, dists, initial_verts);
+            vert_positions, v2, v1, SCULPT_GEODESIC_VERTEX_NONE, dists, initial_vert);
       }
 
       for (const int face : edge_to_face_map[e]) {
@@ -150,7 +148,7 @@ Array<float> distances_create(const Span<float3> vert_positions,
             continue;
           }
           if (sculpt_geodesic_mesh_test_dist_add(
-                  vert_positions, v_other, v1, v2, dists, initial_verts))
+                  vert_positions, v_other, v1, v2, dists, initial_vert))
           {
             for (const int e_other : vert_to_edge_map[v_other]) {
               int ev_other;
@@ -166,7 +164,7 @@ Array<float> distances_create(const Span<float3> vert_positions,
               {
                 if (affected_vert[v_other] || affected_vert[ev_other]) {
                   edge_tag[e_other].set();
-                  BLI_LINKSTACK_PUSH(queue_next, POINTER_FROM_INT(e_other));
+                  queue_next.append(e_other);
                 }
               }
             }
@@ -175,17 +173,13 @@ Array<float> distances_create(const Span<float3> vert_positions,
       }
     }
 
-    for (LinkNode *lnk = queue_next; lnk; lnk = lnk->next) {
-      const int e = POINTER_AS_INT(lnk->link);
+    for (const int e : queue_next) {
       edge_tag[e].reset();
     }
 
-    BLI_LINKSTACK_SWAP(queue, queue_next);
-
-  } while (BLI_LINKSTACK_SIZE(queue));
+    std::swap(queue, queue_next);
 
-  BLI_LINKSTACK_FREE(queue);
-  BLI_LINKSTACK_FREE(queue_next);
+  } while (!queue.is_empty());
 
   return dists;
 }
@@ -9,9 +9,9 @@
 #pragma once
 
 #include "BLI_array.hh"
+#include "BLI_index_mask_fwd.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_offset_indices.hh"
-#include "BLI_set.hh"
 
 namespace blender::ed::sculpt_paint::geodesic {
 
@@ -26,7 +26,7 @@ Array<float> distances_create(Span<float3> vert_positions,
                               GroupedSpan<int> vert_to_edge_map,
                               GroupedSpan<int> edge_to_face_map,
                               Span<bool> hide_poly,
-                              const Set<int> &initial_verts,
+                              const IndexMask &initial_verts,
                               float limit_radius);
 
 }  // namespace blender::ed::sculpt_paint::geodesic
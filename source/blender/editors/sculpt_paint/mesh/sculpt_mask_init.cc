@@ -106,7 +106,9 @@ static void init_mask_grids(
       },
       exec_mode::grain_size(1));
   pbvh.tag_masks_changed(node_mask);
-  BKE_subdiv_ccg_average_grids(subdiv_ccg);
+  IndexMaskMemory memory;
+  BKE_subdiv_ccg_average_stitch_faces(
+      subdiv_ccg, bke::pbvh::nodes_to_face_selection_grids(subdiv_ccg, nodes, node_mask, memory));
 }
 
 static wmOperatorStatus sculpt_mask_init_exec(bContext *C, wmOperator *op)
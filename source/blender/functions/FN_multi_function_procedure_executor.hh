@@ -17,6 +17,12 @@ class ProcedureExecutor : public MultiFunction {
  private:
   Signature signature_;
   const Procedure &procedure_;
+  /**
+   * True when large masks can be split into smaller chunks that are evaluated one after another.
+   * That is only done when all called functions are cheap, otherwise it is better to keep the
+   * larger mask so that the functions can use multi-threading internally.
+   */
+  bool supports_chunked_execution_ = false;
 
  public:
   ProcedureExecutor(const Procedure &procedure);
@@ -258,6 +258,18 @@ struct ScheduledNodes {
     return priority_.size() + normal_.size();
   }
 
+  /**
+   * Move all nodes from the other group into this one, keeping their order.
+   */
+  void extend(ScheduledNodes &other)
+  {
+    BLI_assert(this != &other);
+    priority_.extend(other.priority_);
+    normal_.extend(other.normal_);
+    other.priority_.clear();
+    other.normal_.clear();
+  }
+
   /**
    * Split up the scheduled nodes into two groups that can be worked on in parallel.
    */
@@ -773,21 +785,63 @@ class GenericGraphExecutor {
   }
 
   void schedule_node(LockedNode &locked_node, CurrentTask &current_task, const bool is_priority)
+  {
+    if (!this->try_set_node_scheduled(locked_node)) {
+      return;
+    }
+    const FunctionNode &node = static_cast<const FunctionNode &>(locked_node.node);
+    if (this->use_multi_threading()) {
+      std::lock_guard lock{current_task.mutex};
+      current_task.scheduled_nodes.schedule(node, is_priority);
+    }
+    else {
+      current_task.scheduled_nodes.schedule(node, is_priority);
+    }
+    current_task.has_scheduled_nodes.store(true, std::memory_order_relaxed);
+  }
+
+  /**
+   * Same as above, but the node is added to a separate batch that has to be passed to
+   * #schedule_nodes_batch afterwards. This is useful when many nodes are scheduled at once.
+   */
+  void schedule_node(LockedNode &locked_node, ScheduledNodes &r_batch, const bool is_priority)
+  {
+    if (!this->try_set_node_scheduled(locked_node)) {
+      return;
+    }
+    r_batch.schedule(static_cast<const FunctionNode &>(locked_node.node), is_priority);
+  }
+
+  /**
+   * Add all nodes of the batch to the current task. This locks the current task only once
+   * instead of once for every node.
+   */
+  void schedule_nodes_batch(ScheduledNodes &batch, CurrentTask &current_task)
+  {
+    if (batch.is_empty()) {
+      return;
+    }
+    if (this->use_multi_threading()) {
+      std::lock_guard lock{current_task.mutex};
+      current_task.scheduled_nodes.extend(batch);
+    }
+    else {
+      current_task.scheduled_nodes.extend(batch);
+    }
+    current_task.has_scheduled_nodes.store(true, std::memory_order_relaxed);
+  }
+
+  /**
+   * Update the schedule state of the node. Returns true when the node has to be added to a list
+   * of scheduled nodes by the caller.
+   */
+  bool try_set_node_scheduled(LockedNode &locked_node)
   {
     BLI_assert(locked_node.node.is_function());
     switch (locked_node.node_state.schedule_state) {
       case NodeScheduleState::NotScheduled: {
         locked_node.node_state.schedule_state = NodeScheduleState::Scheduled;
-        const FunctionNode &node = static_cast<const FunctionNode &>(locked_node.node);
-        if (this->use_multi_threading()) {
-          std::lock_guard lock{current_task.mutex};
-          current_task.scheduled_nodes.schedule(node, is_priority);
-        }
-        else {
-          current_task.scheduled_nodes.schedule(node, is_priority);
-        }
-        current_task.has_scheduled_nodes.store(true, std::memory_order_relaxed);
-        break;
+        return true;
       }
       case NodeScheduleState::Scheduled: {
         break;
@@ -800,6 +854,7 @@ class GenericGraphExecutor {
         break;
       }
     }
+    return false;
   }
 
   void with_locked_node(const Node &node,
@@ -1158,6 +1213,9 @@ class GenericGraphExecutor {
       self_.logger_->log_socket_value(from_socket, value_to_forward, local_context);
     }
 
+    /* Nodes that become ready are collected first and added to the current task all at once.
+     * Values with many targets would otherwise lock the current task many times. */
+    ScheduledNodes newly_scheduled_nodes;
     const Span<const InputSocket *> targets = from_socket.targets();
     for (const InputSocket *target_socket : targets) {
       const Node &target_node = target_socket->node();
@@ -1206,16 +1264,18 @@ class GenericGraphExecutor {
             if (is_last_target) {
               /* No need to make a copy if this is the last target. */
               this->forward_value_to_input(
-                  locked_node, input_state, value_to_forward, current_task);
+                  locked_node, input_state, value_to_forward, newly_scheduled_nodes);
               value_to_forward = {};
             }
             else {
               void *buffer = local_data.allocator->allocate(type);
               type.copy_construct(value_to_forward.get(), buffer);
-              this->forward_value_to_input(locked_node, input_state, {type, buffer}, current_task);
+              this->forward_value_to_input(
+                  locked_node, input_state, {type, buffer}, newly_scheduled_nodes);
             }
           });
     }
+    this->schedule_nodes_batch(newly_scheduled_nodes, current_task);
     if (value_to_forward.get() != nullptr) {
       value_to_forward.destruct();
     }
@@ -1224,7 +1284,7 @@ class GenericGraphExecutor {
   void forward_value_to_input(LockedNode &locked_node,
                               InputState &input_state,
                               GMutablePointer value,
-                              CurrentTask &current_task)
+                              ScheduledNodes &r_scheduled_nodes)
   {
     NodeState &node_state = locked_node.node_state;
 
@@ -1239,7 +1299,7 @@ class GenericGraphExecutor {
                                                  .function()
                                                  .allow_missing_requested_inputs()))
       {
-        this->schedule_node(locked_node, current_task, false);
+        this->schedule_node(locked_node, r_scheduled_nodes, false);
       }
     }
   }
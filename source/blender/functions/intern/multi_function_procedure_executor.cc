@@ -8,6 +8,32 @@
 
 namespace blender::fn::multi_function {
 
+/**
+ * Number of indices that go through the entire procedure before the next indices are processed.
+ * This keeps the intermediate buffers small enough to stay in the CPU cache between instructions,
+ * instead of streaming every intermediate array through main memory.
+ */
+static constexpr int64_t execution_chunk_size = 2048;
+
+static bool procedure_supports_chunked_execution(const Procedure &procedure)
+{
+  for (const ConstParameter &param : procedure.params()) {
+    if (param.variable->data_type().is_vector()) {
+      /* Vector parameters can't be sliced. */
+      return false;
+    }
+  }
+  const int64_t default_grain_size = MultiFunction::ExecutionHints().min_grain_size;
+  for (const CallInstruction *instruction : procedure.call_instructions()) {
+    const MultiFunction::ExecutionHints hints = instruction->fn().execution_hints();
+    if (hints.allocates_array || hints.min_grain_size < default_grain_size) {
+      /* Expensive functions benefit more from being multi-threaded over all indices at once. */
+      return false;
+    }
+  }
+  return true;
+}
+
 ProcedureExecutor::ProcedureExecutor(const Procedure &procedure) : procedure_(procedure)
 {
   SignatureBuilder builder("Procedure Executor", signature_);
@@ -17,6 +43,7 @@ ProcedureExecutor::ProcedureExecutor(const Procedure &procedure) : procedure_(pr
   }
 
   this->set_signature(&signature_);
+  supports_chunked_execution_ = procedure_supports_chunked_execution(procedure);
 }
 
 using IndicesSplitVectors = std::array<Vector<int64_t>, 2>;
@@ -813,17 +840,17 @@ class VariableState : NonCopyable, NonMovable {
 /** Keeps track of the states of all variables during evaluation. */
 class VariableStates {
  private:
-  ValueAllocator value_allocator_;
+  ValueAllocator &value_allocator_;
   const Procedure &procedure_;
   /** The state of every variable, indexed by #Variable::index_in_procedure(). */
   Array<VariableState> variable_states_;
   const IndexMask &full_mask_;
 
  public:
-  VariableStates(LinearAllocator<> &linear_allocator,
+  VariableStates(ValueAllocator &value_allocator,
                  const Procedure &procedure,
                  const IndexMask &full_mask)
-      : value_allocator_(linear_allocator),
+      : value_allocator_(value_allocator),
         procedure_(procedure),
         variable_states_(procedure.variables().size()),
         full_mask_(full_mask)
@@ -1157,19 +1184,18 @@ class InstructionScheduler {
   }
 };
 
-void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context context) const
+static void execute_procedure(const ProcedureExecutor &fn,
+                              const Procedure &procedure,
+                              const IndexMask &full_mask,
+                              Params params,
+                              Context context,
+                              ValueAllocator &value_allocator)
 {
-  BLI_assert(procedure_.validate());
-
-  AlignedBuffer<512, 64> local_buffer;
-  LinearAllocator<> linear_allocator;
-  linear_allocator.provide_buffer(local_buffer);
-
-  VariableStates variable_states{linear_allocator, procedure_, full_mask};
-  variable_states.add_initial_variable_states(*this, procedure_, params);
+  VariableStates variable_states{value_allocator, procedure, full_mask};
+  variable_states.add_initial_variable_states(fn, procedure, params);
 
   InstructionScheduler scheduler;
-  scheduler.add_referenced_indices(*procedure_.entry(), full_mask);
+  scheduler.add_referenced_indices(*procedure.entry(), full_mask);
 
   /* Loop until all indices got to a return instruction. */
   while (!scheduler.is_done()) {
@@ -1218,9 +1244,9 @@ void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context
     }
   }
 
-  for (const int param_index : this->param_indices()) {
-    const ParamType param_type = this->param_type(param_index);
-    const Variable *variable = procedure_.params()[param_index].variable;
+  for (const int param_index : fn.param_indices()) {
+    const ParamType param_type = fn.param_type(param_index);
+    const Variable *variable = procedure.params()[param_index].variable;
     VariableState &variable_state = variable_states.get_variable_state(*variable);
     switch (param_type.interface_type()) {
       case ParamType::Input: {
@@ -1241,6 +1267,69 @@ void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context
   }
 }
 
+static void add_sliced_parameters(const ProcedureExecutor &fn,
+                                  Params &full_params,
+                                  const IndexRange slice_range,
+                                  ParamsBuilder &r_sliced_params)
+{
+  for (const int param_index : fn.param_indices()) {
+    const ParamType param_type = fn.param_type(param_index);
+    switch (param_type.category()) {
+      case ParamCategory::SingleInput: {
+        const GVArray &varray = full_params.readonly_single_input(param_index);
+        r_sliced_params.add_readonly_single_input(varray.slice(slice_range));
+        break;
+      }
+      case ParamCategory::SingleMutable: {
+        const GMutableSpan span = full_params.single_mutable(param_index);
+        r_sliced_params.add_single_mutable(span.slice(slice_range));
+        break;
+      }
+      case ParamCategory::SingleOutput: {
+        const GMutableSpan span = full_params.uninitialized_single_output(param_index);
+        r_sliced_params.add_uninitialized_single_output(span.slice(slice_range));
+        break;
+      }
+      case ParamCategory::VectorInput:
+      case ParamCategory::VectorMutable:
+      case ParamCategory::VectorOutput: {
+        BLI_assert_unreachable();
+        break;
+      }
+    }
+  }
+}
+
+void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context context) const
+{
+  BLI_assert(procedure_.validate());
+
+  AlignedBuffer<512, 64> local_buffer;
+  LinearAllocator<> linear_allocator;
+  linear_allocator.provide_buffer(local_buffer);
+  ValueAllocator value_allocator{linear_allocator};
+
+  const std::optional<IndexRange> full_range = full_mask.to_range();
+  if (!supports_chunked_execution_ || !full_range.has_value() ||
+      full_range->size() <= execution_chunk_size)
+  {
+    execute_procedure(*this, procedure_, full_mask, params, context, value_allocator);
+    return;
+  }
+
+  /* Run all instructions on one chunk before starting with the next. The indices of every chunk
+   * are shifted to start at zero, so all chunks except the last one need intermediate buffers of
+   * the same size. This allows the value allocator to reuse them across chunks. */
+  for (int64_t start = 0; start < full_range->size(); start += execution_chunk_size) {
+    const int64_t size = std::min(execution_chunk_size, full_range->size() - start);
+    const IndexRange chunk_range = full_range->slice(start, size);
+    const IndexMask chunk_mask(size);
+    ParamsBuilder chunk_params{*this, &chunk_mask};
+    add_sliced_parameters(*this, params, chunk_range, chunk_params);
+    execute_procedure(*this, procedure_, chunk_mask, chunk_params, context, value_allocator);
+  }
+}
+
 MultiFunction::ExecutionHints ProcedureExecutor::get_execution_hints() const
 {
   ExecutionHints hints;
@@ -427,4 +427,63 @@ TEST_F(MultiFunctionProcedureTest, OutputBufferReplaced)
   EXPECT_EQ(output[2], output_value);
 }
 
+TEST_F(MultiFunctionProcedureTest, ChunkedExecution)
+{
+  /**
+   * procedure(int a, int b, int *out) {
+   *   int c = a + b;
+   *   int d = c * 2;
+   *   out = d + a;
+   * }
+   */
+
+  auto add_fn = build::SI2_SO<int, int, int>("add", [](int a, int b) { return a + b; });
+  auto double_fn = build::SI1_SO<int, int>("double", [](int a) { return a * 2; });
+
+  Procedure procedure;
+  ProcedureBuilder builder{procedure};
+
+  Variable *var_a = &builder.add_single_input_parameter<int>();
+  Variable *var_b = &builder.add_single_input_parameter<int>();
+  auto [var_c] = builder.add_call<1>(add_fn, {var_a, var_b});
+  builder.add_destruct(*var_b);
+  auto [var_d] = builder.add_call<1>(double_fn, {var_c});
+  builder.add_destruct(*var_c);
+  auto [var_out] = builder.add_call<1>(add_fn, {var_d, var_a});
+  builder.add_destruct({var_a, var_d});
+  builder.add_return();
+  builder.add_output_parameter(*var_out);
+
+  EXPECT_TRUE(procedure.validate());
+
+  ProcedureExecutor procedure_fn{procedure};
+
+  /* Use a mask that is large enough to be split into multiple chunks, and that doesn't start at
+   * zero. */
+  const int size = 10000;
+  Array<int> inputs(size);
+  for (const int i : inputs.index_range()) {
+    inputs[i] = i;
+  }
+  Array<int> results(size, -1);
+
+  const IndexMask mask(IndexRange(100, 9000));
+  ParamsBuilder params{procedure_fn, &mask};
+  params.add_readonly_single_input(inputs.as_span());
+  params.add_readonly_single_input_value(3);
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  ContextBuilder context;
+  procedure_fn.call(mask, params, context);
+
+  for (const int i : results.index_range()) {
+    if (mask.contains(i)) {
+      EXPECT_EQ(results[i], (i + 3) * 2 + i);
+    }
+    else {
+      EXPECT_EQ(results[i], -1);
+    }
+  }
+}
+
 }  // namespace blender::fn::multi_function::tests
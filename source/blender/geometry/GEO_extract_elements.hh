@@ -4,10 +4,13 @@
 
 #pragma once
 
+#include "BKE_attribute_enums.hh"
 #include "BKE_attribute_filter.hh"
 
 #include "BLI_array.hh"
+#include "BLI_generic_virtual_array.hh"
 #include "BLI_index_mask_fwd.hh"
+#include "BLI_vector.hh"
 
 namespace blender {
 
@@ -22,17 +25,39 @@ class Instances;
 
 namespace geometry {
 
+/**
+ * Mesh attributes that are propagated to the extracted elements of a specific domain, already
+ * interpolated to the domain they are stored on in the elements. Interpolating them is done for
+ * the entire mesh, so it should only be done once when the elements are extracted in multiple
+ * parts.
+ */
+struct MeshElementAttributes {
+  struct Attribute {
+    StringRef name;
+    bke::AttrType data_type;
+    bke::AttrDomain domain;
+    GVArray data;
+  };
+  Vector<Attribute> attributes;
+};
+
+/**
+ * \param domain: The domain of the elements that are extracted: point, edge or face.
+ */
+MeshElementAttributes prepare_mesh_element_attributes(
+    const Mesh &mesh, bke::AttrDomain domain, const bke::AttributeFilter &attribute_filter);
+
 Array<Mesh *> extract_mesh_vertices(const Mesh &mesh,
                                     const IndexMask &mask,
-                                    const bke::AttributeFilter &attribute_filter);
+                                    const MeshElementAttributes &attributes);
 
 Array<Mesh *> extract_mesh_edges(const Mesh &mesh,
                                  const IndexMask &mask,
-                                 const bke::AttributeFilter &attribute_filter);
+                                 const MeshElementAttributes &attributes);
 
 Array<Mesh *> extract_mesh_faces(const Mesh &mesh,
                                  const IndexMask &mask,
-                                 const bke::AttributeFilter &attribute_filter);
+                                 const MeshElementAttributes &attributes);
 
 Array<PointCloud *> extract_pointcloud_points(const PointCloud &pointcloud,
                                               const IndexMask &mask,
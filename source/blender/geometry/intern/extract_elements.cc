@@ -18,20 +18,11 @@ namespace blender::geometry {
 
 using bke::AttrDomain;
 
-struct PropagationAttribute {
-  StringRef name;
-  bke::AttrType data_type;
-  AttrDomain domain;
-  GVArray data;
-};
+using PropagationAttribute = MeshElementAttributes::Attribute;
 
-Array<Mesh *> extract_mesh_vertices(const Mesh &mesh,
-                                    const IndexMask &mask,
-                                    const bke::AttributeFilter &attribute_filter)
+static Vector<PropagationAttribute> prepare_vertex_attributes(
+    const Mesh &mesh, const bke::AttributeFilter &attribute_filter)
 {
-  BLI_assert(mask.min_array_size() <= mesh.verts_num);
-  Array<Mesh *> elements(mask.size(), nullptr);
-
   const bke::AttributeAccessor src_attributes = mesh.attributes();
 
   Vector<PropagationAttribute> propagation_attributes;
@@ -48,39 +39,12 @@ Array<Mesh *> extract_mesh_vertices(const Mesh &mesh,
     }
     propagation_attributes.append({iter.name, iter.data_type, AttrDomain::Point, *src_attribute});
   });
-
-  mask.foreach_index(
-      [&](const int vert_i, const int element_i) {
-        Mesh *element = BKE_mesh_new_nomain(1, 0, 0, 0);
-        BKE_mesh_copy_parameters_for_eval(element, &mesh);
-
-        bke::MutableAttributeAccessor element_attributes = element->attributes_for_write();
-
-        for (const PropagationAttribute &src_attribute : propagation_attributes) {
-          bke::GSpanAttributeWriter dst = element_attributes.lookup_or_add_for_write_only_span(
-              src_attribute.name, AttrDomain::Point, src_attribute.data_type);
-          if (!dst) {
-            continue;
-          }
-          src_attribute.data.get(vert_i, dst.span[0]);
-          dst.finish();
-        }
-
-        elements[element_i] = element;
-      },
-      exec_mode::grain_size(32));
-
-  return elements;
+  return propagation_attributes;
 }
 
-Array<Mesh *> extract_mesh_edges(const Mesh &mesh,
-                                 const IndexMask &mask,
-                                 const bke::AttributeFilter &attribute_filter)
+static Vector<PropagationAttribute> prepare_edge_attributes(
+    const Mesh &mesh, const bke::AttributeFilter &attribute_filter)
 {
-  BLI_assert(mask.min_array_size() <= mesh.edges_num);
-  Array<Mesh *> elements(mask.size(), nullptr);
-
-  const Span<int2> src_edges = mesh.edges();
   const bke::AttributeAccessor src_attributes = mesh.attributes();
 
   Vector<PropagationAttribute> propagation_attributes;
@@ -116,6 +80,95 @@ Array<Mesh *> extract_mesh_edges(const Mesh &mesh,
       }
     }
   });
+  return propagation_attributes;
+}
+
+static Vector<PropagationAttribute> prepare_face_attributes(
+    const Mesh &mesh, const bke::AttributeFilter &attribute_filter)
+{
+  const bke::AttributeAccessor src_attributes = mesh.attributes();
+
+  Vector<PropagationAttribute> propagation_attributes;
+  src_attributes.foreach_attribute([&](const bke::AttributeIter &iter) {
+    if (iter.data_type == bke::AttrType::String) {
+      return;
+    }
+    if (ELEM(iter.name, ".edge_verts", ".corner_edge", ".corner_vert")) {
+      return;
+    }
+    if (attribute_filter.allow_skip(iter.name)) {
+      return;
+    }
+    const bke::GAttributeReader src_attribute = iter.get();
+    if (!src_attribute) {
+      return;
+    }
+    propagation_attributes.append(
+        {iter.name, iter.data_type, src_attribute.domain, *src_attribute});
+  });
+  return propagation_attributes;
+}
+
+MeshElementAttributes prepare_mesh_element_attributes(
+    const Mesh &mesh, const AttrDomain domain, const bke::AttributeFilter &attribute_filter)
+{
+  MeshElementAttributes attributes;
+  switch (domain) {
+    case AttrDomain::Point:
+      attributes.attributes = prepare_vertex_attributes(mesh, attribute_filter);
+      break;
+    case AttrDomain::Edge:
+      attributes.attributes = prepare_edge_attributes(mesh, attribute_filter);
+      break;
+    case AttrDomain::Face:
+      attributes.attributes = prepare_face_attributes(mesh, attribute_filter);
+      break;
+    default:
+      BLI_assert_unreachable();
+      break;
+  }
+  return attributes;
+}
+
+Array<Mesh *> extract_mesh_vertices(const Mesh &mesh,
+                                    const IndexMask &mask,
+                                    const MeshElementAttributes &attributes)
+{
+  BLI_assert(mask.min_array_size() <= mesh.verts_num);
+  Array<Mesh *> elements(mask.size(), nullptr);
+
+  mask.foreach_index(
+      [&](const int vert_i, const int element_i) {
+        Mesh *element = BKE_mesh_new_nomain(1, 0, 0, 0);
+        BKE_mesh_copy_parameters_for_eval(element, &mesh);
+
+        bke::MutableAttributeAccessor element_attributes = element->attributes_for_write();
+
+        for (const PropagationAttribute &src_attribute : attributes.attributes) {
+          bke::GSpanAttributeWriter dst = element_attributes.lookup_or_add_for_write_only_span(
+              src_attribute.name, AttrDomain::Point, src_attribute.data_type);
+          if (!dst) {
+            continue;
+          }
+          src_attribute.data.get(vert_i, dst.span[0]);
+          dst.finish();
+        }
+
+        elements[element_i] = element;
+      },
+      exec_mode::grain_size(32));
+
+  return elements;
+}
+
+Array<Mesh *> extract_mesh_edges(const Mesh &mesh,
+                                 const IndexMask &mask,
+                                 const MeshElementAttributes &attributes)
+{
+  BLI_assert(mask.min_array_size() <= mesh.edges_num);
+  Array<Mesh *> elements(mask.size(), nullptr);
+
+  const Span<int2> src_edges = mesh.edges();
 
   mask.foreach_index(
       [&](const int edge_i, const int element_i) {
@@ -127,7 +180,7 @@ Array<Mesh *> extract_mesh_edges(const Mesh &mesh,
         const int2 &src_edge = src_edges[edge_i];
 
         bke::MutableAttributeAccessor element_attributes = element->attributes_for_write();
-        for (const PropagationAttribute &src_attribute : propagation_attributes) {
+        for (const PropagationAttribute &src_attribute : attributes.attributes) {
           bke::GSpanAttributeWriter dst = element_attributes.lookup_or_add_for_write_only_span(
               src_attribute.name, src_attribute.domain, src_attribute.data_type);
           if (!dst) {
@@ -151,7 +204,7 @@ Array<Mesh *> extract_mesh_edges(const Mesh &mesh,
 
 Array<Mesh *> extract_mesh_faces(const Mesh &mesh,
                                  const IndexMask &mask,
-                                 const bke::AttributeFilter &attribute_filter)
+                                 const MeshElementAttributes &attributes)
 {
   BLI_assert(mask.min_array_size() <= mesh.faces_num);
   Array<Mesh *> elements(mask.size(), nullptr);
@@ -160,27 +213,6 @@ Array<Mesh *> extract_mesh_faces(const Mesh &mesh,
   const Span<int> src_corner_edges = mesh.corner_edges();
   const OffsetIndices<int> src_faces = mesh.faces();
 
-  const bke::AttributeAccessor src_attributes = mesh.attributes();
-
-  Vector<PropagationAttribute> propagation_attributes;
-  src_attributes.foreach_attribute([&](const bke::AttributeIter &iter) {
-    if (iter.data_type == bke::AttrType::String) {
-      return;
-    }
-    if (ELEM(iter.name, ".edge_verts", ".corner_edge", ".corner_vert")) {
-      return;
-    }
-    if (attribute_filter.allow_skip(iter.name)) {
-      return;
-    }
-    const bke::GAttributeReader src_attribute = iter.get();
-    if (!src_attribute) {
-      return;
-    }
-    propagation_attributes.append(
-        {iter.name, iter.data_type, src_attribute.domain, *src_attribute});
-  });
-
   mask.foreach_index(
       [&](const int face_i, const int element_i) {
         const IndexRange src_face = src_faces[face_i];
@@ -204,7 +236,7 @@ Array<Mesh *> extract_mesh_faces(const Mesh &mesh,
         element_face_offsets[1] = verts_num;
 
         bke::MutableAttributeAccessor element_attributes = element->attributes_for_write();
-        for (const PropagationAttribute &src_attribute : propagation_attributes) {
+        for (const PropagationAttribute &src_attribute : attributes.attributes) {
           bke::GSpanAttributeWriter dst = element_attributes.lookup_or_add_for_write_only_span(
               src_attribute.name, src_attribute.domain, src_attribute.data_type);
           if (!dst) {
@@ -14,6 +14,9 @@
 
 #include "BLI_array.hh"
 #include "BLI_array_utils.hh"
+#include "BLI_atomic_disjoint_set.hh"
+#include "BLI_bounds.hh"
+#include "BLI_kdopbvh.hh"
 #include "BLI_math_geom_c.hh"
 #include "BLI_math_matrix.hh"
 #include "BLI_math_matrix_c.hh"
@@ -1081,6 +1084,157 @@ static int operation_to_float_mode(const Operation operation)
   return BMESH_ISECT_BOOLEAN_NONE;
 }
 
+/**
+ * Concatenate the meshes into a #BMesh and do the boolean operation between the first mesh and
+ * all other meshes. #BMESH_ISECT_BOOLEAN_NONE just joins the meshes.
+ */
+static Mesh *mesh_boolean_float_concat(Span<const Mesh *> meshes,
+                                       Span<float4x4> transforms,
+                                       Span<Array<short>> material_remaps,
+                                       const Mesh &template_mesh,
+                                       const int boolean_mode)
+{
+  Array<std::array<BMLoop *, 3>> looptris;
+  BMesh *bm = mesh_bm_concat(meshes, transforms, material_remaps, looptris);
+  if (boolean_mode != BMESH_ISECT_BOOLEAN_NONE) {
+    BM_mesh_intersect(bm,
+                      looptris,
+                      face_boolean_operand,
+                      nullptr,
+                      false,
+                      false,
+                      true,
+                      true,
+                      false,
+                      false,
+                      boolean_mode,
+                      1e-6f);
+  }
+  Mesh *result = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, &template_mesh);
+  BM_mesh_free(bm);
+  return result;
+}
+
+/** Operand of the n-ary float union, either an input mesh or an intermediate result. */
+struct FloatUnionOperand {
+  const Mesh *mesh = nullptr;
+  float4x4 transform = float4x4::identity();
+  Array<short> material_remap;
+  /** Intermediate results are owned and freed once they are used. */
+  bool is_owned = false;
+};
+
+static void free_float_union_operand(FloatUnionOperand &operand)
+{
+  if (operand.is_owned) {
+    BKE_id_free(nullptr, const_cast<Mesh *>(operand.mesh));
+  }
+  operand = {};
+}
+
+/**
+ * Union all operands of a cluster of (potentially) overlapping meshes. Instead of a serial chain,
+ * the operands are combined pairwise in a balanced tree, and the pairs on each level are
+ * processed in parallel.
+ */
+static FloatUnionOperand union_float_cluster(Vector<FloatUnionOperand> operands,
+                                             const Mesh &template_mesh)
+{
+  while (operands.size() > 1) {
+    Vector<FloatUnionOperand> next_operands(operands.size() / 2 + operands.size() % 2);
+    threading::parallel_for(next_operands.index_range(), 1, [&](const IndexRange range) {
+      for (const int i : range) {
+        if (2 * i + 1 == operands.size()) {
+          next_operands[i] = std::move(operands[2 * i]);
+          continue;
+        }
+        FloatUnionOperand &a = operands[2 * i];
+        FloatUnionOperand &b = operands[2 * i + 1];
+        const std::array<const Mesh *, 2> meshes = {a.mesh, b.mesh};
+        const std::array<float4x4, 2> transforms = {a.transform, b.transform};
+        const std::array<Array<short>, 2> remaps = {a.material_remap, b.material_remap};
+        next_operands[i].mesh = mesh_boolean_float_concat(
+            meshes, transforms, remaps, template_mesh, BMESH_ISECT_BOOLEAN_UNION);
+        next_operands[i].is_owned = true;
+        free_float_union_operand(a);
+        free_float_union_operand(b);
+      }
+    });
+    operands = std::move(next_operands);
+  }
+  return std::move(operands.first());
+}
+
+/**
+ * Union of many meshes with the float solver. Operands are grouped into clusters whose bounds
+ * overlap. Different clusters can't intersect, so they are processed in parallel and their
+ * results just have to be joined in the end.
+ */
+static Mesh *mesh_boolean_float_union_nary(Span<const Mesh *> meshes,
+                                           Span<float4x4> transforms,
+                                           Span<Array<short>> material_remaps)
+{
+  const int meshes_num = meshes.size();
+
+  BVHTree *tree = BLI_bvhtree_new(meshes_num, 0.0f, 2, 6);
+  for (const int i : meshes.index_range()) {
+    if (const std::optional<Bounds<float3>> bounds = meshes[i]->bounds_min_max()) {
+      const Bounds<float3> transformed = bounds::transform_bounds(transforms[i], *bounds);
+      const float3 co[2] = {transformed.min, transformed.max};
+      BLI_bvhtree_insert(tree, i, reinterpret_cast<const float *>(co), 2);
+    }
+  }
+  BLI_bvhtree_balance(tree);
+  uint overlaps_num = 0;
+  BVHTreeOverlap *overlaps = BLI_bvhtree_overlap_self(tree, &overlaps_num, nullptr, nullptr);
+  BLI_bvhtree_free(tree);
+
+  AtomicDisjointSet clusters(meshes_num);
+  for (const BVHTreeOverlap &overlap : Span(overlaps, overlaps_num)) {
+    clusters.join(overlap.indexA, overlap.indexB);
+  }
+  MEM_SAFE_DELETE(overlaps);
+
+  Array<int> cluster_ids(meshes_num);
+  const int clusters_num = clusters.calc_reduced_ids(cluster_ids);
+  Array<Vector<FloatUnionOperand>> operands_by_cluster(clusters_num);
+  for (const int i : meshes.index_range()) {
+    operands_by_cluster[cluster_ids[i]].append({meshes[i], transforms[i], material_remaps[i]});
+  }
+
+  Array<FloatUnionOperand> cluster_results(clusters_num);
+  threading::parallel_for(cluster_results.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      cluster_results[i] = union_float_cluster(std::move(operands_by_cluster[i]), *meshes[0]);
+    }
+  });
+
+  Mesh *result;
+  if (clusters_num == 1 && cluster_results[0].is_owned) {
+    result = const_cast<Mesh *>(cluster_results[0].mesh);
+    cluster_results[0].is_owned = false;
+  }
+  else {
+    Array<const Mesh *> result_meshes(clusters_num);
+    Array<float4x4> result_transforms(clusters_num);
+    Array<Array<short>> result_remaps(clusters_num);
+    for (const int i : IndexRange(clusters_num)) {
+      result_meshes[i] = cluster_results[i].mesh;
+      result_transforms[i] = cluster_results[i].transform;
+      result_remaps[i] = cluster_results[i].material_remap;
+    }
+    result = mesh_boolean_float_concat(result_meshes,
+                                       result_transforms,
+                                       result_remaps,
+                                       *meshes[0],
+                                       BMESH_ISECT_BOOLEAN_NONE);
+  }
+  for (FloatUnionOperand &operand : cluster_results) {
+    free_float_union_operand(operand);
+  }
+  return result;
+}
+
 static Mesh *mesh_boolean_float(Span<const Mesh *> meshes,
                                 Span<float4x4> transforms,
                                 Span<Array<short>> material_remaps,
@@ -1099,24 +1253,22 @@ static Mesh *mesh_boolean_float(Span<const Mesh *> meshes,
     return BKE_mesh_copy_for_eval(*meshes[0]);
   }
 
-  Array<std::array<BMLoop *, 3>> looptris;
   if (meshes.size() == 2) {
-    BMesh *bm = mesh_bm_concat(meshes, transforms, material_remaps, looptris);
-    BM_mesh_intersect(bm,
-                      looptris,
-                      face_boolean_operand,
-                      nullptr,
-                      false,
-                      false,
-                      true,
-                      true,
-                      false,
-                      false,
-                      boolean_mode,
-                      1e-6f);
-    Mesh *result = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, meshes[0]);
-    BM_mesh_free(bm);
-    return result;
+    return mesh_boolean_float_concat(
+        meshes, transforms, material_remaps, *meshes[0], boolean_mode);
+  }
+
+  if (boolean_mode == BMESH_ISECT_BOOLEAN_UNION) {
+    /* Faces of operands are flipped when their transform's handedness differs from the first
+     * mesh. Intermediate results have an identity transform, so they can only be combined in
+     * arbitrary order if no operand is flipped. */
+    const bool is_negative = math::is_negative(transforms[0]);
+    if (std::all_of(transforms.begin(), transforms.end(), [&](const float4x4 &transform) {
+          return math::is_negative(transform) == is_negative;
+        }))
+    {
+      return mesh_boolean_float_union_nary(meshes, transforms, material_remaps);
+    }
   }
 
   /* Iteratively operate with each operand. */
@@ -1125,21 +1277,8 @@ static Mesh *mesh_boolean_float(Span<const Mesh *> meshes,
   Array<Array<short>> two_remaps = {material_remaps[0], material_remaps[1]};
   Mesh *prev_result_mesh = nullptr;
   for (const int i : meshes.index_range().drop_back(1)) {
-    BMesh *bm = mesh_bm_concat(two_meshes, two_transforms, two_remaps, looptris);
-    BM_mesh_intersect(bm,
-                      looptris,
-                      face_boolean_operand,
-                      nullptr,
-                      false,
-                      false,
-                      true,
-                      true,
-                      false,
-                      false,
-                      boolean_mode,
-                      1e-6f);
-    Mesh *result_i_mesh = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, meshes[0]);
-    BM_mesh_free(bm);
+    Mesh *result_i_mesh = mesh_boolean_float_concat(
+        two_meshes, two_transforms, two_remaps, *meshes[0], boolean_mode);
     if (prev_result_mesh != nullptr) {
       /* Except in the first iteration, two_meshes[0] holds the intermediate
        * mesh result from the previous iteration. */
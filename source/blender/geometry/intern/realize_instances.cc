@@ -2941,6 +2941,11 @@ RealizeInstancesResult realize_instances(bke::GeometrySet geometry_set,
    * 2. Gather "tasks" that need to be executed to realize the instances. Each task corresponds
    * to instances of the previously preprocessed geometry.
    * 3. Execute all tasks in parallel.
+   *
+   * NOTE: The entire result is always allocated at once. Realizing in bounded chunks would only
+   * reduce peak memory for a consumer that can write the result in parts. Bakes store instances
+   * without realizing them, and exporters get instances from the depsgraph as separate objects,
+   * so there is no such consumer currently.
    */
 
   if (!geometry_set.has_instances()) {
@@ -0,0 +1,101 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_array_utils.hh"
+#include "BLI_index_mask.hh"
+
+#include "BKE_attribute.hh"
+#include "BKE_gtest_base.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+
+#include "DNA_mesh_types.h"
+
+#include "GEO_extract_elements.hh"
+#include "GEO_mesh_primitive_grid.hh"
+
+#include "testing/testing.h"
+
+namespace blender {
+
+using namespace blender::bke;
+
+namespace geometry::tests {
+
+class ExtractElementsTest : public bke::BlenderGTestBase {};
+
+static Mesh *create_test_mesh()
+{
+  Mesh *mesh = create_grid_mesh(5, 4, 1.0f, 1.0f, std::nullopt);
+  MutableAttributeAccessor attributes = mesh->attributes_for_write();
+
+  SpanAttributeWriter<float> corner_values = attributes.lookup_or_add_for_write_span<float>(
+      "corner_value", AttrDomain::Corner);
+  array_utils::fill_index_range(corner_values.span);
+  corner_values.finish();
+
+  SpanAttributeWriter<float> face_values = attributes.lookup_or_add_for_write_span<float>(
+      "face_value", AttrDomain::Face);
+  array_utils::fill_index_range(face_values.span);
+  face_values.finish();
+
+  return mesh;
+}
+
+static void free_meshes(Span<Mesh *> meshes)
+{
+  for (Mesh *mesh : meshes) {
+    BKE_id_free(nullptr, mesh);
+  }
+}
+
+TEST_F(ExtractElementsTest, MeshEdgesWithCornerAndFaceAttributes)
+{
+  Mesh *mesh = create_test_mesh();
+  const Span<int2> edges = mesh->edges();
+  const AttributeAccessor attributes = mesh->attributes();
+  const VArraySpan<float> corner_values_on_points = *attributes.lookup<float>(
+      "corner_value", AttrDomain::Point);
+  const VArraySpan<float> face_values_on_edges = *attributes.lookup<float>("face_value",
+                                                                           AttrDomain::Edge);
+
+  const MeshElementAttributes element_attributes = prepare_mesh_element_attributes(
+      *mesh, AttrDomain::Edge, {});
+
+  /* Extract the edges in two parts reusing the same prepared attributes, like the For Each
+   * Geometry Element zone does. */
+  const IndexRange all_edges = edges.index_range();
+  const IndexRange first_part = all_edges.take_front(all_edges.size() / 2);
+  const IndexRange second_part = all_edges.drop_front(first_part.size());
+  const Array<Mesh *> first_elements = extract_mesh_edges(*mesh, first_part, element_attributes);
+  const Array<Mesh *> second_elements = extract_mesh_edges(
+      *mesh, second_part, element_attributes);
+  EXPECT_EQ(first_elements.size(), first_part.size());
+  EXPECT_EQ(second_elements.size(), second_part.size());
+
+  for (const int edge_i : all_edges) {
+    const Mesh *element = first_part.contains(edge_i) ?
+                              first_elements[edge_i] :
+                              second_elements[edge_i - second_part.start()];
+    EXPECT_EQ(element->verts_num, 2);
+    EXPECT_EQ(element->edges_num, 1);
+
+    const AttributeAccessor element_attributes = element->attributes();
+    const VArraySpan<float> corner_values = *element_attributes.lookup<float>("corner_value");
+    EXPECT_EQ(element_attributes.lookup_meta_data("corner_value")->domain, AttrDomain::Point);
+    EXPECT_EQ(corner_values[0], corner_values_on_points[edges[edge_i][0]]);
+    EXPECT_EQ(corner_values[1], corner_values_on_points[edges[edge_i][1]]);
+
+    const VArraySpan<float> face_values = *element_attributes.lookup<float>("face_value");
+    EXPECT_EQ(element_attributes.lookup_meta_data("face_value")->domain, AttrDomain::Edge);
+    EXPECT_EQ(face_values[0], face_values_on_edges[edge_i]);
+  }
+
+  free_meshes(first_elements);
+  free_meshes(second_elements);
+  BKE_id_free(nullptr, mesh);
+}
+
+}  // namespace geometry::tests
+}  // namespace blender
@@ -746,7 +746,7 @@ struct PreviewImage {
 
 /* Check whether data-block type requires copy-on-evaluation from #ID_RECALC_PARAMETERS.
  * Keep in sync with #BKE_id_eval_properties_copy. */
-#define ID_TYPE_SUPPORTS_PARAMS_WITHOUT_COW(id_type) ELEM(id_type, ID_ME)
+#define ID_TYPE_SUPPORTS_PARAMS_WITHOUT_COW(id_type) ELEM(id_type, ID_ME, ID_CV)
 
 /* This used to be ELEM(id_type, ID_IP), currently there is no deprecated ID
  * type. ID_IP was removed in Blender 5.0. */
@@ -871,7 +871,8 @@ struct UserDef_Experimental {
    * actually remove this flag is tracked in #158903. */
   char use_remote_asset_libraries = 1;
   char use_collection_importer = 0;
-  char _pad[4] = {};
+  char use_geometry_nodes_result_cache = 0;
+  char _pad[3] = {};
 };
 
 #define USER_EXPERIMENTAL_TEST(userdef, member) (((userdef)->experimental).member)
@@ -319,6 +319,20 @@ static void rna_Curves_update_data(Main * /*bmain*/, Scene * /*scene*/, PointerR
   }
 }
 
+/**
+ * For properties with #PROP_NO_DEG_UPDATE. Tagging only the parameters copies the settings
+ * synced by #BKE_id_eval_properties_copy, instead of the whole data-block.
+ */
+static void rna_Curves_update_params(Main * /*bmain*/, Scene * /*scene*/, PointerRNA *ptr)
+{
+  ID *id = ptr->owner_id;
+  /* Avoid updates for importers creating curves. */
+  if (id->us > 0) {
+    DEG_id_tag_update(id, ID_RECALC_PARAMETERS);
+    WM_main_add_notifier(NC_GEOM | ND_DATA, id);
+  }
+}
+
 void rna_Curves_update_draw(Main * /*bmain*/, Scene * /*scene*/, PointerRNA *ptr)
 {
   ID *id = ptr->owner_id;
@@ -556,7 +570,8 @@ static void rna_def_curves(BlenderRNA *brna)
   RNA_def_property_enum_items(prop, rna_enum_attribute_curves_domain_items);
   RNA_def_property_ui_text(prop, "Selection Domain", "");
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
-  RNA_def_property_update(prop, 0, "rna_Curves_update_data");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE);
+  RNA_def_property_update(prop, 0, "rna_Curves_update_params");
 
   prop = RNA_def_property(srna, "use_sculpt_collision", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "flag", CV_SCULPT_COLLISION_ENABLED);
@@ -0,0 +1,50 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup nodes
+ *
+ * Opt-in cache for the outputs of individual geometry nodes. When the same node is evaluated
+ * again with the same properties and inputs, e.g. because an unrelated part of the node tree
+ * changed, its outputs are taken from #memory_cache instead of being recomputed.
+ *
+ * Inputs are identified by their value for simple types, by a deep hash for fields and by the
+ * identity and version of the geometry components for geometry. Geometry that is recreated in
+ * every evaluation (like the original geometry passed into a modifier) therefore never results in
+ * a cache hit, but geometry that is passed through unchanged (e.g. from other objects or from
+ * other cached nodes) does.
+ */
+
+#include "BLI_function_ref.hh"
+
+#include "FN_lazy_function.hh"
+
+namespace blender {
+
+struct bNode;
+
+namespace nodes {
+
+namespace lf = fn::lazy_function;
+
+/** True if the cache should be used for the given node. */
+bool node_result_cache_is_enabled(const bNode &node);
+
+/**
+ * Set the node's outputs in \a params, either from the cache or by calling \a execute_fn and
+ * caching its results. All inputs have to be available already.
+ *
+ * \return False if the node can't be cached with its current inputs. Then nothing is done and the
+ * caller has to execute the node itself.
+ */
+bool execute_node_with_result_cache(const bNode &node,
+                                    const lf::LazyFunction &fn,
+                                    lf::Params &params,
+                                    const lf::Context &context,
+                                    FunctionRef<void(lf::Params &params)> execute_fn);
+
+}  // namespace nodes
+}  // namespace blender
@@ -622,6 +622,13 @@ class NodeDeclaration {
    */
   bool is_context_dependent = false;
 
+  /**
+   * The node's outputs only depend on its inputs and properties, so they can be reused from a
+   * previous evaluation when those did not change. Only worth it for nodes that are expensive
+   * compared to hashing their inputs.
+   */
+  bool supports_result_cache = false;
+
   friend NodeDeclarationBuilder;
 
   /** Asserts that the declaration is considered valid. */
@@ -683,6 +690,7 @@ class NodeDeclarationBuilder : public DeclarationListBuilder {
 
   void use_custom_socket_order(bool enable = true);
   void allow_any_socket_order(bool enable = true);
+  void supports_result_cache(bool enable = true);
 
   rl::RelationsInNode &get_reference_lifetime_relations()
   {
@@ -23,6 +23,7 @@ namespace blender::nodes::node_geo_boolean_cc {
 
 static void node_declare(NodeDeclarationBuilder &b)
 {
+  b.supports_result_cache();
   const bNode *node = b.node_or_null();
 
   auto &first_geometry = b.add_input<decl::Geometry>("Mesh 1"_ustr)
@@ -4,6 +4,8 @@
 
 #include "DNA_pointcloud_types.h"
 
+#include "BLI_task.hh"
+
 #include "BKE_curves.hh"
 #include "BKE_grease_pencil.hh"
 #include "BKE_instances.hh"
@@ -24,14 +26,77 @@ namespace blender::nodes::node_geo_convex_hull_cc {
 
 static void node_declare(NodeDeclarationBuilder &b)
 {
+  b.supports_result_cache();
   b.add_input<decl::Geometry>("Geometry"_ustr).description("Points to compute the convex hull of");
   b.add_output<decl::Geometry>("Convex Hull"_ustr).propagate_all_geometry();
 }
 
 #ifdef WITH_BULLET
 
+/** Inputs with fewer points are not split into multiple hull computations. */
+static constexpr int64_t hull_chunk_size = 64 * 1024;
+
+/**
+ * The convex hull of a set of points is the convex hull of the vertices of the hulls of any
+ * partition of the points. Compute the hulls of chunks of the input in parallel, which usually
+ * discards most points, and repeat until there is nothing to gain anymore.
+ */
+static Array<float3> reduce_to_hull_candidates(const Span<float3> coords)
+{
+  Array<float3> candidates;
+  Span<float3> remaining = coords;
+  while (remaining.size() > hull_chunk_size * 2) {
+    const int64_t chunks_num = divide_ceil_ul(remaining.size(), hull_chunk_size);
+    Array<Vector<float3>> hull_verts_by_chunk(chunks_num);
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+      for (const int64_t chunk_i : range) {
+        const Span<float3> chunk = remaining.slice(
+            IndexRange(chunk_i * hull_chunk_size, hull_chunk_size)
+                .intersect(remaining.index_range()));
+        plConvexHull hull = plConvexHullCompute((float (*)[3])chunk.data(), chunk.size());
+        const int verts_num = plConvexHullNumVertices(hull);
+        Vector<float3> &hull_verts = hull_verts_by_chunk[chunk_i];
+        hull_verts.reserve(verts_num);
+        for (const int i : IndexRange(verts_num)) {
+          float3 dummy_co;
+          int original_index;
+          plConvexHullGetVertex(hull, i, dummy_co, &original_index);
+          if (chunk.index_range().contains(original_index)) {
+            /* Use the original position to avoid changing the result. */
+            hull_verts.append(chunk[original_index]);
+          }
+        }
+        plConvexHullDelete(hull);
+      }
+    });
+
+    int64_t candidates_num = 0;
+    for (const Vector<float3> &hull_verts : hull_verts_by_chunk) {
+      candidates_num += hull_verts.size();
+    }
+    if (candidates_num > remaining.size() / 2) {
+      /* The points are mostly on the hull already, more passes won't help. */
+      break;
+    }
+    Array<float3> new_candidates(candidates_num);
+    int64_t offset = 0;
+    for (const Vector<float3> &hull_verts : hull_verts_by_chunk) {
+      new_candidates.as_mutable_span().slice(offset, hull_verts.size()).copy_from(hull_verts);
+      offset += hull_verts.size();
+    }
+    candidates = std::move(new_candidates);
+    remaining = candidates;
+  }
+  return candidates;
+}
+
 static Mesh *hull_from_bullet(const Mesh *mesh, Span<float3> coords)
 {
+  const Array<float3> candidates = reduce_to_hull_candidates(coords);
+  if (!candidates.is_empty()) {
+    coords = candidates;
+  }
+
   plConvexHull hull = plConvexHullCompute((float (*)[3])coords.data(), coords.size());
 
   const int verts_num = plConvexHullNumVertices(hull);
@@ -211,18 +276,20 @@ static void convex_hull_grease_pencil(GeometrySet &geometry_set)
   const GreasePencil &grease_pencil = *geometry_set.get_grease_pencil();
   Array<Mesh *> mesh_by_layer(grease_pencil.layers().size(), nullptr);
 
-  for (const int layer_index : grease_pencil.layers().index_range()) {
-    const Drawing *drawing = grease_pencil.get_eval_drawing(grease_pencil.layer(layer_index));
-    if (drawing == nullptr) {
-      continue;
-    }
-    const bke::CurvesGeometry &curves = drawing->strokes();
-    const Span<float3> positions_span = curves.evaluated_positions();
-    if (positions_span.is_empty()) {
-      continue;
+  threading::parallel_for(grease_pencil.layers().index_range(), 1, [&](const IndexRange range) {
+    for (const int layer_index : range) {
+      const Drawing *drawing = grease_pencil.get_eval_drawing(grease_pencil.layer(layer_index));
+      if (drawing == nullptr) {
+        continue;
+      }
+      const bke::CurvesGeometry &curves = drawing->strokes();
+      const Span<float3> positions_span = curves.evaluated_positions();
+      if (positions_span.is_empty()) {
+        continue;
+      }
+      mesh_by_layer[layer_index] = hull_from_bullet(nullptr, positions_span);
     }
-    mesh_by_layer[layer_index] = hull_from_bullet(nullptr, positions_span);
-  }
+  });
 
   if (mesh_by_layer.is_empty()) {
     return;
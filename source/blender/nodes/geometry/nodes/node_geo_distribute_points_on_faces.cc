@@ -2,10 +2,15 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_generic_key.hh"
 #include "BLI_kdtree.hh"
+#include "BLI_map.hh"
 #include "BLI_math_geom_c.hh"
 #include "BLI_math_quaternion.hh"
 #include "BLI_math_rotation_c.hh"
+#include "BLI_memory_cache.hh"
+#include "BLI_memory_counter.hh"
+#include "BLI_mutex.hh"
 #include "BLI_noise.hh"
 #include "BLI_rand.hh"
 #include "BLI_task.hh"
@@ -25,12 +30,15 @@
 #include "GEO_foreach_geometry.hh"
 #include "GEO_randomize.hh"
 
+#include "NOD_geometry_nodes_result_cache.hh"
+
 #include "node_geometry_util.hh"
 
 namespace blender::nodes::node_geo_distribute_points_on_faces_cc {
 
 static void node_declare(NodeDeclarationBuilder &b)
 {
+  b.supports_result_cache();
   auto enable_random = [](bNode &node) {
     node.custom1 = GEO_NODE_POINT_DISTRIBUTE_POINTS_ON_FACES_RANDOM;
   };
@@ -110,6 +118,19 @@ static math::Quaternion normal_to_rotation(const float3 normal)
   return math::normalize(math::Quaternion(quat));
 }
 
+static int calc_tri_points_num(const float3 &v0_pos,
+                               const float3 &v1_pos,
+                               const float3 &v2_pos,
+                               const float density,
+                               const int tri_i,
+                               const int seed)
+{
+  const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
+  const int corner_tri_seed = noise::hash(tri_i, seed);
+  RandomNumberGenerator corner_tri_rng(corner_tri_seed);
+  return corner_tri_rng.round_probabilistic(area * density);
+}
+
 static OffsetIndices<int> calc_tri_point_offsets(const Mesh &mesh,
                                                  const Span<float> densities,
                                                  const int seed,
@@ -124,12 +145,12 @@ static OffsetIndices<int> calc_tri_point_offsets(const Mesh &mesh,
     for (const int64_t tri_i : range) {
       const int3 &tri = corner_tris[tri_i];
       const float density = (densities[tri[0]] + densities[tri[1]] + densities[tri[2]]) / 3.0f;
-      const float area = area_tri_v3(positions[corner_verts[tri[0]]],
-                                     positions[corner_verts[tri[1]]],
-                                     positions[corner_verts[tri[2]]]);
-      const int corner_tri_seed = noise::hash(tri_i, seed);
-      RandomNumberGenerator corner_tri_rng(corner_tri_seed);
-      r_count_data[tri_i] = corner_tri_rng.round_probabilistic(area * density);
+      r_count_data[tri_i] = calc_tri_points_num(positions[corner_verts[tri[0]]],
+                                                positions[corner_verts[tri[1]]],
+                                                positions[corner_verts[tri[2]]],
+                                                density,
+                                                tri_i,
+                                                seed);
     }
   });
 
@@ -149,18 +170,42 @@ static OffsetIndices<int> calc_tri_point_offsets(const Mesh &mesh,
   threading::parallel_for(corner_tris.index_range(), 1024, [&](const IndexRange range) {
     for (const int64_t tri_i : range) {
       const int3 &tri = corner_tris[tri_i];
-      const float area = area_tri_v3(positions[corner_verts[tri[0]]],
-                                     positions[corner_verts[tri[1]]],
-                                     positions[corner_verts[tri[2]]]);
-      const int corner_tri_seed = noise::hash(tri_i, seed);
-      RandomNumberGenerator corner_tri_rng(corner_tri_seed);
-      r_count_data[tri_i] = corner_tri_rng.round_probabilistic(area * density);
+      r_count_data[tri_i] = calc_tri_points_num(positions[corner_verts[tri[0]]],
+                                                positions[corner_verts[tri[1]]],
+                                                positions[corner_verts[tri[2]]],
+                                                density,
+                                                tri_i,
+                                                seed);
     }
   });
 
   return offset_indices::accumulate_counts_to_offsets(r_count_data);
 }
 
+static void sample_tri_points(const float3 &v0_pos,
+                              const float3 &v1_pos,
+                              const float3 &v2_pos,
+                              const int tri_i,
+                              const int seed,
+                              const IndexRange points,
+                              MutableSpan<float3> r_positions,
+                              MutableSpan<float3> r_bary_coords,
+                              MutableSpan<int> r_tri_indices)
+{
+  const int corner_tri_seed = noise::hash(tri_i, seed);
+  RandomNumberGenerator corner_tri_rng(corner_tri_seed);
+
+  /* Retain legacy behavior. */
+  corner_tri_rng.skip(1);
+
+  for (const int i : points) {
+    const float3 bary_coord = corner_tri_rng.get_barycentric_coordinates();
+    r_positions[i] = bke::attribute_math::mix3(bary_coord, v0_pos, v1_pos, v2_pos);
+    r_bary_coords[i] = bary_coord;
+    r_tri_indices[i] = tri_i;
+  }
+}
+
 static void sample_bary_coords(const Mesh &mesh,
                                const int seed,
                                const OffsetIndices<int> points_by_tri,
@@ -182,22 +227,15 @@ static void sample_bary_coords(const Mesh &mesh,
       [&](const IndexRange range) {
         for (const int64_t tri_i : range) {
           const int3 &tri = corner_tris[tri_i];
-          const float3 &v0_pos = positions[corner_verts[tri[0]]];
-          const float3 &v1_pos = positions[corner_verts[tri[1]]];
-          const float3 &v2_pos = positions[corner_verts[tri[2]]];
-
-          const int corner_tri_seed = noise::hash(tri_i, seed);
-          RandomNumberGenerator corner_tri_rng(corner_tri_seed);
-
-          /* Retain legacy behavior. */
-          corner_tri_rng.skip(1);
-
-          for (const int i : points_by_tri[tri_i]) {
-            const float3 bary_coord = corner_tri_rng.get_barycentric_coordinates();
-            r_positions[i] = bke::attribute_math::mix3(bary_coord, v0_pos, v1_pos, v2_pos);
-            r_bary_coords[i] = bary_coord;
-            r_tri_indices[i] = tri_i;
-          }
+          sample_tri_points(positions[corner_verts[tri[0]]],
+                            positions[corner_verts[tri[1]]],
+                            positions[corner_verts[tri[2]]],
+                            tri_i,
+                            seed,
+                            points_by_tri[tri_i],
+                            r_positions,
+                            r_bary_coords,
+                            r_tri_indices);
         }
       },
       threading::accumulated_task_sizes(
@@ -522,33 +560,388 @@ static Array<float> calc_full_density_factors_with_selection(const Mesh &mesh,
   return densities;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Incremental Random Distribution
+ *
+ * The random distribution is seeded per triangle, so the points on a triangle only depend on the
+ * triangle's positions and density. When the node is evaluated again on a mesh with the same
+ * topology, only triangles that changed are sampled again, and the points on all other triangles
+ * are copied from the previous evaluation. The result is the same as sampling all triangles.
+ * \{ */
+
+/** Identifies the node evaluation whose previous result is reused. */
+struct IncrementalDistributionId {
+  ComputeContextHash context_hash;
+  int32_t node_id;
+};
+
+/**
+ * Identifies the distribution of a node evaluation on a specific mesh topology. The topology is
+ * identified by the corner verts array and its version. The cached distribution keeps a weak
+ * user, so that the address is not reused by other data while it exists.
+ */
+struct RandomDistributionSlot {
+  IncrementalDistributionId id;
+  int seed;
+  const ImplicitSharingInfo *corner_verts_sharing_info;
+  int64_t corner_verts_version;
+
+  uint64_t hash() const
+  {
+    return get_default_hash(
+        id.context_hash, id.node_id, seed, corner_verts_sharing_info, corner_verts_version);
+  }
+
+  friend bool operator==(const RandomDistributionSlot &a, const RandomDistributionSlot &b)
+  {
+    return a.id.context_hash == b.id.context_hash && a.id.node_id == b.id.node_id &&
+           a.seed == b.seed && a.corner_verts_sharing_info == b.corner_verts_sharing_info &&
+           a.corner_verts_version == b.corner_verts_version;
+  }
+};
+
+/**
+ * Cached values can't be replaced, so the result of every evaluation is stored with a new
+ * generation number.
+ */
+class RandomDistributionKey : public GenericKey {
+ public:
+  RandomDistributionSlot slot;
+  int64_t generation;
+
+  RandomDistributionKey(const RandomDistributionSlot &slot, const int64_t generation)
+      : slot(slot), generation(generation)
+  {
+  }
+
+  uint64_t hash() const override
+  {
+    return get_default_hash(slot, generation);
+  }
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    if (const auto *other_typed = dynamic_cast<const RandomDistributionKey *>(&other)) {
+      return slot == other_typed->slot && generation == other_typed->generation;
+    }
+    return false;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<RandomDistributionKey>(*this);
+  }
+};
+
+/** The inputs and outputs of an evaluation. It is not changed after it has been cached. */
+class RandomDistribution : public memory_cache::CachedValue {
+ public:
+  WeakImplicitSharingPtr corner_verts_sharing_info;
+  WeakImplicitSharingPtr vert_positions_sharing_info;
+  int64_t vert_positions_version = 0;
+  Array<float3> vert_positions;
+  Array<float> tri_densities;
+  /** Empty if the distribution has been freed from the cache already. */
+  Array<int> points_by_tri_data;
+  Array<float3> positions;
+  Array<float3> bary_coords;
+  Array<int> tri_indices;
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    memory.add(this->vert_positions.as_span().size_in_bytes());
+    memory.add(this->tri_densities.as_span().size_in_bytes());
+    memory.add(this->points_by_tri_data.as_span().size_in_bytes());
+    memory.add(this->positions.as_span().size_in_bytes());
+    memory.add(this->bary_coords.as_span().size_in_bytes());
+    memory.add(this->tri_indices.as_span().size_in_bytes());
+  }
+};
+
+/**
+ * The generation of the latest distribution of every slot. The distributions themselves are
+ * stored in the memory cache, so that they count towards its limit.
+ */
+struct LatestRandomDistributions {
+  Mutex mutex;
+  Map<RandomDistributionSlot, int64_t> generations;
+  int64_t next_generation = 0;
+};
+
+/** Forget all slots when there are more, they are re-added by the next evaluation. */
+static constexpr int64_t latest_random_distributions_max_num = 4096;
+
+static LatestRandomDistributions &get_latest_random_distributions()
+{
+  static LatestRandomDistributions latest;
+  return latest;
+}
+
+static std::shared_ptr<const RandomDistribution> find_previous_random_distribution(
+    const RandomDistributionSlot &slot)
+{
+  LatestRandomDistributions &latest = get_latest_random_distributions();
+  std::optional<int64_t> generation;
+  {
+    std::lock_guard lock{latest.mutex};
+    generation = latest.generations.lookup_try(slot);
+  }
+  if (!generation) {
+    return nullptr;
+  }
+  /* An empty value is added when the distribution has been freed already. */
+  std::shared_ptr<const RandomDistribution> previous = memory_cache::get<RandomDistribution>(
+      RandomDistributionKey(slot, *generation),
+      []() { return std::make_unique<RandomDistribution>(); });
+  if (previous->points_by_tri_data.is_empty()) {
+    return nullptr;
+  }
+  return previous;
+}
+
+static void add_random_distribution(const RandomDistributionSlot &slot,
+                                    std::unique_ptr<RandomDistribution> distribution)
+{
+  LatestRandomDistributions &latest = get_latest_random_distributions();
+  int64_t generation;
+  {
+    std::lock_guard lock{latest.mutex};
+    generation = latest.next_generation++;
+  }
+  memory_cache::get<RandomDistribution>(RandomDistributionKey(slot, generation),
+                                        [&]() { return std::move(distribution); });
+  std::lock_guard lock{latest.mutex};
+  if (latest.generations.size() >= latest_random_distributions_max_num) {
+    latest.generations.clear();
+  }
+  latest.generations.add_overwrite(slot, generation);
+}
+
+static Array<float> calc_tri_densities(const Mesh &mesh,
+                                       const Span<float> corner_densities,
+                                       const float density)
+{
+  const Span<int3> corner_tris = mesh.corner_tris();
+  Array<float> tri_densities(corner_tris.size());
+  if (corner_densities.is_empty()) {
+    tri_densities.fill(density);
+    return tri_densities;
+  }
+  threading::parallel_for(corner_tris.index_range(), 4096, [&](const IndexRange range) {
+    for (const int tri_i : range) {
+      const int3 &tri = corner_tris[tri_i];
+      tri_densities[tri_i] = (corner_densities[tri[0]] + corner_densities[tri[1]] +
+                              corner_densities[tri[2]]) /
+                             3.0f;
+    }
+  });
+  return tri_densities;
+}
+
+/**
+ * Find the triangles whose points have to be recomputed. Faces with any moved vertex are
+ * recomputed entirely, because their triangulation may have changed.
+ */
+static IndexMask calc_changed_tris(const Mesh &mesh,
+                                   const RandomDistribution &previous,
+                                   const bool vert_positions_changed,
+                                   const Span<float> tri_densities,
+                                   IndexMaskMemory &memory)
+{
+  const Span<float3> vert_positions = mesh.vert_positions();
+  const OffsetIndices faces = mesh.faces();
+  const Span<int> corner_verts = mesh.corner_verts();
+  const Span<int> tri_faces = mesh.corner_tri_faces();
+
+  Array<bool> face_changed(faces.size(), false);
+  if (vert_positions_changed) {
+    threading::parallel_for(faces.index_range(), 2048, [&](const IndexRange range) {
+      for (const int face : range) {
+        for (const int vert : corner_verts.slice(faces[face])) {
+          if (vert_positions[vert] != previous.vert_positions[vert]) {
+            face_changed[face] = true;
+            break;
+          }
+        }
+      }
+    });
+  }
+  return IndexMask::from_predicate(tri_faces.index_range(), memory, [&](const int tri_i) {
+    return face_changed[tri_faces[tri_i]] || tri_densities[tri_i] != previous.tri_densities[tri_i];
+  });
+}
+
+/**
+ * Same as #calc_tri_point_offsets followed by #sample_bary_coords, but reuses the points of
+ * unchanged triangles from the previous evaluation of the node.
+ *
+ * \param corner_densities: Densities on the corner domain, or empty if \a density is used for
+ * the entire mesh.
+ * \return False if the mesh data can't be identified and nothing was done.
+ */
+static bool sample_random_incremental(const IncrementalDistributionId &id,
+                                      const Mesh &mesh,
+                                      const Span<float> corner_densities,
+                                      const float density,
+                                      const int seed,
+                                      Vector<float3> &r_positions,
+                                      Vector<float3> &r_bary_coords,
+                                      Vector<int> &r_tri_indices)
+{
+  const bke::AttributeAccessor attributes = mesh.attributes();
+  const bke::GAttributeReader corner_verts_attr = attributes.lookup(".corner_vert");
+  const bke::GAttributeReader vert_positions_attr = attributes.lookup("position");
+  if (!corner_verts_attr.sharing_info || !vert_positions_attr.sharing_info) {
+    return false;
+  }
+
+  const RandomDistributionSlot slot{
+      id, seed, corner_verts_attr.sharing_info, corner_verts_attr.sharing_info->version()};
+
+  const Span<float3> vert_positions = mesh.vert_positions();
+  const Span<int> corner_verts = mesh.corner_verts();
+  const Span<int3> corner_tris = mesh.corner_tris();
+  Array<float> tri_densities = calc_tri_densities(mesh, corner_densities, density);
+
+  std::shared_ptr<const RandomDistribution> previous = find_previous_random_distribution(slot);
+  if (previous && (previous->tri_densities.size() != corner_tris.size() ||
+                   previous->vert_positions.size() != vert_positions.size()))
+  {
+    previous.reset();
+  }
+
+  const bool vert_positions_changed = !previous ||
+                                      previous->vert_positions_sharing_info.get() !=
+                                          vert_positions_attr.sharing_info ||
+                                      previous->vert_positions_version !=
+                                          vert_positions_attr.sharing_info->version();
+
+  IndexMaskMemory memory;
+  const IndexMask changed_tris = previous ? calc_changed_tris(mesh,
+                                                              *previous,
+                                                              vert_positions_changed,
+                                                              tri_densities,
+                                                              memory) :
+                                            IndexMask(corner_tris.size());
+
+  Array<int> points_by_tri_data(corner_tris.size() + 1);
+  if (previous) {
+    offset_indices::copy_group_sizes(OffsetIndices<int>(previous->points_by_tri_data),
+                                     corner_tris.index_range(),
+                                     points_by_tri_data.as_mutable_span().drop_back(1));
+  }
+  changed_tris.foreach_index(
+      [&](const int tri_i) {
+        const int3 &tri = corner_tris[tri_i];
+        points_by_tri_data[tri_i] = calc_tri_points_num(vert_positions[corner_verts[tri[0]]],
+                                                        vert_positions[corner_verts[tri[1]]],
+                                                        vert_positions[corner_verts[tri[2]]],
+                                                        tri_densities[tri_i],
+                                                        tri_i,
+                                                        seed);
+      },
+      exec_mode::grain_size(1024));
+  const OffsetIndices<int> points_by_tri = offset_indices::accumulate_counts_to_offsets(
+      points_by_tri_data);
+
+  const int points_num = points_by_tri.total_size();
+  r_positions.resize(points_num);
+  r_bary_coords.resize(points_num);
+  r_tri_indices.resize(points_num);
+
+  Array<bool> tri_changed(corner_tris.size());
+  changed_tris.to_bools(tri_changed);
+
+  threading::parallel_for(
+      corner_tris.index_range(),
+      4096,
+      [&](const IndexRange range) {
+        for (const int64_t tri_i : range) {
+          const IndexRange points = points_by_tri[tri_i];
+          if (!tri_changed[tri_i]) {
+            const IndexRange prev_points = OffsetIndices<int>(previous->points_by_tri_data)[tri_i];
+            r_positions.as_mutable_span().slice(points).copy_from(
+                previous->positions.as_span().slice(prev_points));
+            r_bary_coords.as_mutable_span().slice(points).copy_from(
+                previous->bary_coords.as_span().slice(prev_points));
+            r_tri_indices.as_mutable_span().slice(points).fill(int(tri_i));
+            continue;
+          }
+          const int3 &tri = corner_tris[tri_i];
+          sample_tri_points(vert_positions[corner_verts[tri[0]]],
+                            vert_positions[corner_verts[tri[1]]],
+                            vert_positions[corner_verts[tri[2]]],
+                            tri_i,
+                            seed,
+                            points,
+                            r_positions,
+                            r_bary_coords,
+                            r_tri_indices);
+        }
+      },
+      threading::accumulated_task_sizes(
+          [&](const IndexRange range) { return points_by_tri[range].size(); }));
+
+  auto result = std::make_unique<RandomDistribution>();
+  corner_verts_attr.sharing_info->add_weak_user();
+  result->corner_verts_sharing_info = WeakImplicitSharingPtr(corner_verts_attr.sharing_info);
+  vert_positions_attr.sharing_info->add_weak_user();
+  result->vert_positions_sharing_info = WeakImplicitSharingPtr(vert_positions_attr.sharing_info);
+  result->vert_positions_version = vert_positions_attr.sharing_info->version();
+  result->vert_positions = vert_positions;
+  result->tri_densities = std::move(tri_densities);
+  result->points_by_tri_data = std::move(points_by_tri_data);
+  result->positions = r_positions.as_span();
+  result->bary_coords = r_bary_coords.as_span();
+  result->tri_indices = r_tri_indices.as_span();
+  add_random_distribution(slot, std::move(result));
+  return true;
+}
+
+/** \} */
+
 static PointCloud *create_points_random(const Mesh &mesh,
                                         const Field<bool> &selection_field,
                                         const Field<float> &density_field,
                                         const int seed,
                                         const AttributeOutputs &attribute_outputs,
                                         const bke::AttributeFilter &attribute_filter,
-                                        const bool use_legacy_normal)
+                                        const bool use_legacy_normal,
+                                        const IncrementalDistributionId *incremental_id)
 {
-  Array<int> count_data;
-  OffsetIndices<int> points_by_tri;
+  Array<float> densities;
+  float density = 0.0f;
   if (selection_field.depends_on_input() || density_field.depends_on_input()) {
-    const Array<float> densities = calc_full_density_factors_with_selection(
-        mesh, density_field, selection_field);
-    points_by_tri = calc_tri_point_offsets(mesh, densities, seed, count_data);
+    densities = calc_full_density_factors_with_selection(mesh, density_field, selection_field);
   }
   else {
-    const float density = fn::evaluate_constant_field<float>(density_field);
-    points_by_tri = calc_tri_point_offsets(mesh, density, seed, count_data);
-  }
-  if (points_by_tri.total_size() == 0) {
-    return nullptr;
+    density = fn::evaluate_constant_field<float>(density_field);
   }
 
   Vector<float3> positions;
   Vector<float3> bary_coords;
   Vector<int> tri_indices;
-  sample_bary_coords(mesh, seed, points_by_tri, positions, bary_coords, tri_indices);
+  if (!incremental_id || !sample_random_incremental(*incremental_id,
+                                                    mesh,
+                                                    densities,
+                                                    density,
+                                                    seed,
+                                                    positions,
+                                                    bary_coords,
+                                                    tri_indices))
+  {
+    Array<int> count_data;
+    const OffsetIndices<int> points_by_tri =
+        densities.is_empty() ? calc_tri_point_offsets(mesh, density, seed, count_data) :
+                               calc_tri_point_offsets(mesh, densities, seed, count_data);
+    if (points_by_tri.total_size() == 0) {
+      return nullptr;
+    }
+    sample_bary_coords(mesh, seed, points_by_tri, positions, bary_coords, tri_indices);
+  }
+  if (positions.is_empty()) {
+    return nullptr;
+  }
 
   PointCloud *pointcloud = bke::pointcloud_new_no_attributes(positions.size());
   bke::MutableAttributeAccessor point_attributes = pointcloud->attributes_for_write();
@@ -645,6 +1038,12 @@ static void node_geo_exec(GeoNodeExecParams params)
   attribute_outputs.normal_id = params.get_output_anonymous_attribute_id_if_needed(
       "Normal"_ustr, bool(attribute_outputs.rotation_id));
 
+  /* Reuse points from the previous evaluation when the result cache is enabled. */
+  std::optional<IncrementalDistributionId> incremental_id;
+  if (node_result_cache_is_enabled(params.node())) {
+    incremental_id = {params.user_data()->compute_context->hash(), params.node().identifier};
+  }
+
   lazy_threading::send_hint();
 
   switch (GeometryNodeDistributePointsOnFacesMode(params.node().custom1)) {
@@ -658,7 +1057,9 @@ static void node_geo_exec(GeoNodeExecParams params)
                                                         seed,
                                                         attribute_outputs,
                                                         attribute_filter,
-                                                        use_legacy_normal);
+                                                        use_legacy_normal,
+                                                        incremental_id ? &*incremental_id :
+                                                                         nullptr);
           geometry_set.replace_pointcloud(pointcloud);
         }
         geometry_set.keep_only(
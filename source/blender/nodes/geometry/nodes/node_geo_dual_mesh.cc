@@ -18,6 +18,7 @@ namespace blender::nodes::node_geo_dual_mesh_cc {
 
 static void node_declare(NodeDeclarationBuilder &b)
 {
+  b.supports_result_cache();
   b.use_custom_socket_order();
   b.allow_any_socket_order();
   b.add_input<decl::Geometry>("Mesh"_ustr)
@@ -614,6 +615,118 @@ static void dissolve_redundant_verts(const Span<int2> edges,
   }
 }
 
+/**
+ * Create the faces of the dual mesh for the case where boundaries are not kept, so that only
+ * normal vertices create faces. This gives the same result as the serial loop in
+ * #calc_dual_mesh: every new edge is created by the vertex with the lowest index that uses it, in
+ * the order of the vertex's sorted faces.
+ */
+static void build_dual_faces_from_normal_verts(const Span<VertexType> vertex_types,
+                                               const GroupedSpan<int> vert_to_face_map,
+                                               const Span<Array<int>> vertex_shared_edges,
+                                               const Span<Array<int>> vertex_corners,
+                                               MutableSpan<int> old_to_new_edges_map,
+                                               Vector<int> &face_sizes,
+                                               Vector<int> &corner_verts,
+                                               Vector<int> &corner_edges,
+                                               Vector<int2> &new_edges,
+                                               Vector<int> &new_to_old_face_corners_map,
+                                               Vector<int> &new_to_old_edges_map)
+{
+  IndexMaskMemory memory;
+  const IndexMask face_verts = IndexMask::from_predicate(
+      vertex_types.index_range(), memory, [&](const int vert) {
+        /* Faces can't be made from 2 vertices. */
+        return vertex_types[vert] == VertexType::Normal && vert_to_face_map[vert].size() > 2;
+      });
+
+  /* Find the vertex that creates each edge which has not been created yet. */
+  Array<std::atomic<int>> edge_owners(old_to_new_edges_map.size());
+  threading::parallel_for(edge_owners.index_range(), 4096, [&](const IndexRange range) {
+    for (std::atomic<int> &owner : edge_owners.as_mutable_span().slice(range)) {
+      owner.store(std::numeric_limits<int>::max(), std::memory_order_relaxed);
+    }
+  });
+  face_verts.foreach_index(
+      [&](const int vert) {
+        for (const int old_edge_i : vertex_shared_edges[vert]) {
+          if (old_to_new_edges_map[old_edge_i] != -1) {
+            continue;
+          }
+          std::atomic<int> &owner = edge_owners[old_edge_i];
+          int current = owner.load(std::memory_order_relaxed);
+          while (vert < current &&
+                 !owner.compare_exchange_weak(current, vert, std::memory_order_relaxed))
+          {
+          }
+        }
+      },
+      exec_mode::grain_size(1024));
+
+  /* Count the corners and the created edges of each new face. */
+  const int faces_num = face_verts.size();
+  Array<int> corner_offset_data(faces_num + 1);
+  Array<int> edge_offset_data(faces_num + 1);
+  face_verts.foreach_index(
+      [&](const int vert, const int face) {
+        corner_offset_data[face] = vert_to_face_map[vert].size();
+        int owned_edges_num = 0;
+        for (const int old_edge_i : vertex_shared_edges[vert]) {
+          if (edge_owners[old_edge_i].load(std::memory_order_relaxed) == vert) {
+            owned_edges_num++;
+          }
+        }
+        edge_offset_data[face] = owned_edges_num;
+      },
+      exec_mode::grain_size(2048));
+  const OffsetIndices<int> corner_offsets = offset_indices::accumulate_counts_to_offsets(
+      corner_offset_data);
+  const OffsetIndices<int> edge_offsets = offset_indices::accumulate_counts_to_offsets(
+      edge_offset_data, new_edges.size());
+
+  face_sizes.resize(faces_num);
+  corner_verts.resize(corner_offsets.total_size());
+  corner_edges.resize(corner_offsets.total_size());
+  new_to_old_face_corners_map.resize(corner_offsets.total_size());
+  new_edges.resize(edge_offsets.total_size() + new_edges.size());
+  new_to_old_edges_map.resize(new_edges.size());
+
+  /* Create the new edges and the face corners. */
+  face_verts.foreach_index(
+      [&](const int vert, const int face) {
+        const Span<int> face_indices = vert_to_face_map[vert];
+        const Span<int> shared_edges = vertex_shared_edges[vert];
+        const IndexRange corners = corner_offsets[face];
+        face_sizes[face] = corners.size();
+        corner_verts.as_mutable_span().slice(corners).copy_from(face_indices);
+        new_to_old_face_corners_map.as_mutable_span().slice(corners).copy_from(
+            vertex_corners[vert]);
+        int new_edge_i = edge_offsets[face].start();
+        for (const int i : shared_edges.index_range()) {
+          const int old_edge_i = shared_edges[i];
+          if (edge_owners[old_edge_i].load(std::memory_order_relaxed) != vert) {
+            continue;
+          }
+          new_to_old_edges_map[new_edge_i] = old_edge_i;
+          old_to_new_edges_map[old_edge_i] = new_edge_i;
+          new_edges[new_edge_i] = {face_indices[i], face_indices[(i + 1) % face_indices.size()]};
+          new_edge_i++;
+        }
+      },
+      exec_mode::grain_size(1024));
+
+  /* Edges may have been created by another vertex, so they are only known now. */
+  face_verts.foreach_index(
+      [&](const int vert, const int face) {
+        const Span<int> shared_edges = vertex_shared_edges[vert];
+        MutableSpan<int> face_edges = corner_edges.as_mutable_span().slice(corner_offsets[face]);
+        for (const int i : shared_edges.index_range()) {
+          face_edges[i] = old_to_new_edges_map[shared_edges[i]];
+        }
+      },
+      exec_mode::grain_size(1024));
+}
+
 /**
  * Calculate the barycentric dual of a mesh. The dual is only "dual" in terms of connectivity,
  * i.e. applying the function twice will give the same vertices, edges, and faces, but not the
@@ -702,10 +815,13 @@ static Mesh *calc_dual_mesh(const Mesh &src_mesh,
   const GroupedSpan<int> vert_to_face_map(vert_to_face_offsets, vert_to_face_indices);
 
   Vector<float3> vert_positions(src_mesh.faces_num);
-  for (const int i : src_faces.index_range()) {
-    const IndexRange face = src_faces[i];
-    vert_positions[i] = bke::mesh::face_center_calc(src_positions, src_corner_verts.slice(face));
-  }
+  threading::parallel_for(src_faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange face = src_faces[i];
+      vert_positions[i] = bke::mesh::face_center_calc(src_positions,
+                                                      src_corner_verts.slice(face));
+    }
+  });
 
   Array<int> boundary_edge_midpoint_index;
   if (keep_boundaries) {
@@ -750,157 +866,177 @@ static Mesh *calc_dual_mesh(const Mesh &src_mesh,
                            new_edges,
                            new_to_old_edges_map);
 
-  for (const int i : IndexRange(src_mesh.verts_num)) {
-    if (vertex_types[i] == VertexType::Loose || vertex_types[i] >= VertexType::NonManifold ||
-        (!keep_boundaries && vertex_types[i] == VertexType::Boundary))
-    {
-      /* Bad vertex that we can't work with. */
-      continue;
-    }
-
-    Vector<int> corner_indices = vert_to_face_map[i];
-    Span<int> shared_edges = vertex_shared_edges[i];
-    Span<int> sorted_corners = vertex_corners[i];
-    if (vertex_types[i] == VertexType::Normal) {
-      if (corner_indices.size() <= 2) {
-        /* We can't make a face from 2 vertices. */
+  if (!keep_boundaries) {
+    build_dual_faces_from_normal_verts(vertex_types,
+                                       vert_to_face_map,
+                                       vertex_shared_edges,
+                                       vertex_corners,
+                                       old_to_new_edges_map,
+                                       face_sizes,
+                                       corner_verts,
+                                       corner_edges,
+                                       new_edges,
+                                       new_to_old_face_corners_map,
+                                       new_to_old_edges_map);
+  }
+  else {
+    for (const int i : IndexRange(src_mesh.verts_num)) {
+      if (vertex_types[i] == VertexType::Loose || vertex_types[i] >= VertexType::NonManifold ||
+          (!keep_boundaries && vertex_types[i] == VertexType::Boundary))
+      {
+        /* Bad vertex that we can't work with. */
         continue;
       }
 
-      /* Add edges in the loop. */
-      for (const int i : shared_edges.index_range()) {
-        const int old_edge_i = shared_edges[i];
-        if (old_to_new_edges_map[old_edge_i] == -1) {
-          /* This edge has not been created yet. */
-          new_to_old_edges_map.append(old_edge_i);
-          old_to_new_edges_map[old_edge_i] = new_edges.size();
-          new_edges.append({corner_indices[i], corner_indices[(i + 1) % corner_indices.size()]});
+      Vector<int> corner_indices = vert_to_face_map[i];
+      Span<int> shared_edges = vertex_shared_edges[i];
+      Span<int> sorted_corners = vertex_corners[i];
+      if (vertex_types[i] == VertexType::Normal) {
+        if (corner_indices.size() <= 2) {
+          /* We can't make a face from 2 vertices. */
+          continue;
         }
-        corner_edges.append(old_to_new_edges_map[old_edge_i]);
-      }
 
-      new_to_old_face_corners_map.extend(sorted_corners);
-    }
-    else {
-      /**
-       * The code handles boundary vertices like the vertex marked "V" in the diagram below.
-       * The first thing that happens is ordering the faces f1,f2 and f3 (stored in
-       * corner_indices), together with their shared edges e3 and e4 (which get stored in
-       * shared_edges). The ordering could end up being clockwise or counterclockwise, for this
-       * we'll assume that the ordering f1->f2->f3 is chosen. After that we add the edges in
-       * between the faces, in this case the edges f1--f2, and f2--f3. Now we need to merge
-       * these with the boundary edges e1 and e2. To do this we create an edge from f3 to the
-       * midpoint of e2 (computed in a previous step), from this midpoint to V, from V to the
-       * midpoint of e1 and from the midpoint of e1 to f1.
-       *
-       * \code{.unparsed}
-       *       |       |             |                    |       |            |
-       *       v2 ---- v3 --------- v4---                 v2 ---- v3 -------- v4---
-       *       | f3   /          ,-' |                    |      /          ,-'|
-       *       |     /   f2   ,-'    |                    |     /        ,-'   |
-       *    e2 |    /e3    ,-' e4    |       ====>       M1-f3-/--f2-.,-'      |
-       *       |   /    ,-'          |       ====>        |   /    ,-'\        |
-       *       |  /  ,-'     f1      |                    |  /  ,-'    f1      |
-       *       | /,-'                |                    | /,-'        |      |
-       *       V-------------------- v5---                V------------M2----- v5---
-       * \endcode
-       */
-
-      /* Add the edges in between the faces. */
-      for (const int i : shared_edges.index_range()) {
-        const int old_edge_i = shared_edges[i];
-        if (old_to_new_edges_map[old_edge_i] == -1) {
-          /* This edge has not been created yet. */
-          new_to_old_edges_map.append(old_edge_i);
-          old_to_new_edges_map[old_edge_i] = new_edges.size();
-          new_edges.append({corner_indices[i], corner_indices[i + 1]});
+        /* Add edges in the loop. */
+        for (const int i : shared_edges.index_range()) {
+          const int old_edge_i = shared_edges[i];
+          if (old_to_new_edges_map[old_edge_i] == -1) {
+            /* This edge has not been created yet. */
+            new_to_old_edges_map.append(old_edge_i);
+            old_to_new_edges_map[old_edge_i] = new_edges.size();
+            new_edges.append({corner_indices[i], corner_indices[(i + 1) % corner_indices.size()]});
+          }
+          corner_edges.append(old_to_new_edges_map[old_edge_i]);
         }
-        corner_edges.append(old_to_new_edges_map[old_edge_i]);
-      }
 
-      new_to_old_face_corners_map.extend(sorted_corners);
-
-      /* Add the vertex and the midpoints of the two boundary edges to the loop. */
-
-      /* Get the boundary edges. */
-      int edge1;
-      int edge2;
-      if (corner_indices.size() >= 2) {
-        /* The first boundary edge is at the end of the chain of faces. */
-        boundary_edge_on_face(src_edges,
-                              src_corner_edges.slice(src_faces[corner_indices.last()]),
-                              i,
-                              edge_types,
-                              edge1);
-        boundary_edge_on_face(src_edges,
-                              src_corner_edges.slice(src_faces[corner_indices.first()]),
-                              i,
-                              edge_types,
-                              edge2);
+        new_to_old_face_corners_map.extend(sorted_corners);
       }
       else {
-        /* If there is only one face both edges are in that face. */
-        boundary_edges_on_face(src_faces[corner_indices[0]],
-                               src_edges,
-                               src_corner_verts,
-                               src_corner_edges,
-                               i,
-                               edge_types,
-                               edge1,
-                               edge2);
-      }
+        /**
+         * The code handles boundary vertices like the vertex marked "V" in the diagram below.
+         * The first thing that happens is ordering the faces f1,f2 and f3 (stored in
+         * corner_indices), together with their shared edges e3 and e4 (which get stored in
+         * shared_edges). The ordering could end up being clockwise or counterclockwise, for this
+         * we'll assume that the ordering f1->f2->f3 is chosen. After that we add the edges in
+         * between the faces, in this case the edges f1--f2, and f2--f3. Now we need to merge
+         * these with the boundary edges e1 and e2. To do this we create an edge from f3 to the
+         * midpoint of e2 (computed in a previous step), from this midpoint to V, from V to the
+         * midpoint of e1 and from the midpoint of e1 to f1.
+         *
+         * \code{.unparsed}
+         *       |       |             |                    |       |            |
+         *       v2 ---- v3 --------- v4---                 v2 ---- v3 -------- v4---
+         *       | f3   /          ,-' |                    |      /          ,-'|
+         *       |     /   f2   ,-'    |                    |     /        ,-'   |
+         *    e2 |    /e3    ,-' e4    |       ====>       M1-f3-/--f2-.,-'      |
+         *       |   /    ,-'          |       ====>        |   /    ,-'\        |
+         *       |  /  ,-'     f1      |                    |  /  ,-'    f1      |
+         *       | /,-'                |                    | /,-'        |      |
+         *       V-------------------- v5---                V------------M2----- v5---
+         * \endcode
+         */
+
+        /* Add the edges in between the faces. */
+        for (const int i : shared_edges.index_range()) {
+          const int old_edge_i = shared_edges[i];
+          if (old_to_new_edges_map[old_edge_i] == -1) {
+            /* This edge has not been created yet. */
+            new_to_old_edges_map.append(old_edge_i);
+            old_to_new_edges_map[old_edge_i] = new_edges.size();
+            new_edges.append({corner_indices[i], corner_indices[i + 1]});
+          }
+          corner_edges.append(old_to_new_edges_map[old_edge_i]);
+        }
 
-      const int last_face_center = corner_indices.last();
-      corner_indices.append(boundary_edge_midpoint_index[edge1]);
-      new_to_old_face_corners_map.append(sorted_corners.last());
-      const int first_midpoint = corner_indices.last();
-      if (old_to_new_edges_map[edge1] == -1) {
-        add_edge(edge1,
-                 last_face_center,
-                 first_midpoint,
-                 new_to_old_edges_map,
-                 new_edges,
-                 corner_edges);
-        old_to_new_edges_map[edge1] = new_edges.size() - 1;
-        boundary_vertex_to_relevant_face_map.append(std::pair(first_midpoint, last_face_center));
-      }
-      else {
-        corner_edges.append(old_to_new_edges_map[edge1]);
-      }
-      corner_indices.append(vert_positions.size());
-      /* This is sort of arbitrary, but interpolating would be a lot harder to do. */
-      new_to_old_face_corners_map.append(sorted_corners.first());
-      boundary_vertex_to_relevant_face_map.append(
-          std::pair(corner_indices.last(), last_face_center));
-      vert_positions.append(src_positions[i]);
-      const int boundary_vertex = corner_indices.last();
-      add_edge(
-          edge1, first_midpoint, boundary_vertex, new_to_old_edges_map, new_edges, corner_edges);
-
-      corner_indices.append(boundary_edge_midpoint_index[edge2]);
-      new_to_old_face_corners_map.append(sorted_corners.first());
-      const int second_midpoint = corner_indices.last();
-      add_edge(
-          edge2, boundary_vertex, second_midpoint, new_to_old_edges_map, new_edges, corner_edges);
-
-      if (old_to_new_edges_map[edge2] == -1) {
-        const int first_face_center = corner_indices.first();
+        new_to_old_face_corners_map.extend(sorted_corners);
+
+        /* Add the vertex and the midpoints of the two boundary edges to the loop. */
+
+        /* Get the boundary edges. */
+        int edge1;
+        int edge2;
+        if (corner_indices.size() >= 2) {
+          /* The first boundary edge is at the end of the chain of faces. */
+          boundary_edge_on_face(src_edges,
+                                src_corner_edges.slice(src_faces[corner_indices.last()]),
+                                i,
+                                edge_types,
+                                edge1);
+          boundary_edge_on_face(src_edges,
+                                src_corner_edges.slice(src_faces[corner_indices.first()]),
+                                i,
+                                edge_types,
+                                edge2);
+        }
+        else {
+          /* If there is only one face both edges are in that face. */
+          boundary_edges_on_face(src_faces[corner_indices[0]],
+                                 src_edges,
+                                 src_corner_verts,
+                                 src_corner_edges,
+                                 i,
+                                 edge_types,
+                                 edge1,
+                                 edge2);
+        }
+
+        const int last_face_center = corner_indices.last();
+        corner_indices.append(boundary_edge_midpoint_index[edge1]);
+        new_to_old_face_corners_map.append(sorted_corners.last());
+        const int first_midpoint = corner_indices.last();
+        if (old_to_new_edges_map[edge1] == -1) {
+          add_edge(edge1,
+                   last_face_center,
+                   first_midpoint,
+                   new_to_old_edges_map,
+                   new_edges,
+                   corner_edges);
+          old_to_new_edges_map[edge1] = new_edges.size() - 1;
+          boundary_vertex_to_relevant_face_map.append(std::pair(first_midpoint, last_face_center));
+        }
+        else {
+          corner_edges.append(old_to_new_edges_map[edge1]);
+        }
+        corner_indices.append(vert_positions.size());
+        /* This is sort of arbitrary, but interpolating would be a lot harder to do. */
+        new_to_old_face_corners_map.append(sorted_corners.first());
+        boundary_vertex_to_relevant_face_map.append(
+            std::pair(corner_indices.last(), last_face_center));
+        vert_positions.append(src_positions[i]);
+        const int boundary_vertex = corner_indices.last();
+        add_edge(
+            edge1, first_midpoint, boundary_vertex, new_to_old_edges_map, new_edges, corner_edges);
+
+        corner_indices.append(boundary_edge_midpoint_index[edge2]);
+        new_to_old_face_corners_map.append(sorted_corners.first());
+        const int second_midpoint = corner_indices.last();
         add_edge(edge2,
+                 boundary_vertex,
                  second_midpoint,
-                 first_face_center,
                  new_to_old_edges_map,
                  new_edges,
                  corner_edges);
-        old_to_new_edges_map[edge2] = new_edges.size() - 1;
-        boundary_vertex_to_relevant_face_map.append(std::pair(second_midpoint, first_face_center));
-      }
-      else {
-        corner_edges.append(old_to_new_edges_map[edge2]);
+
+        if (old_to_new_edges_map[edge2] == -1) {
+          const int first_face_center = corner_indices.first();
+          add_edge(edge2,
+                   second_midpoint,
+                   first_face_center,
+                   new_to_old_edges_map,
+                   new_edges,
+                   corner_edges);
+          old_to_new_edges_map[edge2] = new_edges.size() - 1;
+          boundary_vertex_to_relevant_face_map.append(
+              std::pair(second_midpoint, first_face_center));
+        }
+        else {
+          corner_edges.append(old_to_new_edges_map[edge2]);
+        }
       }
-    }
 
-    face_sizes.append(corner_indices.size());
-    corner_verts.extend(corner_indices);
+      face_sizes.append(corner_indices.size());
+      corner_verts.extend(corner_indices);
+    }
   }
   Mesh *mesh_out = BKE_mesh_new_nomain(
       vert_positions.size(), new_edges.size(), face_sizes.size(), corner_verts.size());
@@ -141,6 +141,7 @@ static EnumPropertyItem resolution_mode_items[] = {
 
 static void node_declare(NodeDeclarationBuilder &b)
 {
+  b.supports_result_cache();
   b.add_input<decl::Geometry>("Points"_ustr)
       .is_default_link_socket()
       .description("Points which are converted to a volume");
@@ -140,54 +140,59 @@ static void raycast_to_mesh(const IndexMask &mask,
                             const MutableSpan<float3> r_bary_weights)
 {
   const bke::bvh::Tree &tree_data = mesh.bvh_tris();
-  mask.foreach_index([&](const int i) {
-    bke::bvh::Ray ray{};
-    ray.origin = ray_origins[i];
-    ray.direction = ray_directions[i];
-    ray.dist_max = ray_lengths[i];
-
-    if (const std::optional<bke::bvh::RayHit> hit = tree_data.ray_intersect(ray)) {
-      if (!r_hit.is_empty()) {
-        r_hit[i] = true;
-      }
-      if (!r_hit_indices.is_empty()) {
-        /* The caller must be able to handle invalid indices anyway, so don't clamp this value. */
-        r_hit_indices[i] = hit->index;
-      }
-      if (!r_hit_positions.is_empty()) {
-        r_hit_positions[i] = hit->position(ray);
-      }
-      if (!r_hit_normals.is_empty()) {
-        r_hit_normals[i] = math::normalize(hit->normal);
-      }
-      if (!r_hit_distances.is_empty()) {
-        r_hit_distances[i] = hit->distance;
-      }
-      if (!r_bary_weights.is_empty()) {
-        r_bary_weights[i] = hit->bary_coord;
-      }
-    }
-    else {
-      if (!r_hit.is_empty()) {
-        r_hit[i] = false;
-      }
-      if (!r_hit_indices.is_empty()) {
-        r_hit_indices[i] = -1;
-      }
-      if (!r_hit_positions.is_empty()) {
-        r_hit_positions[i] = float3(0.0f, 0.0f, 0.0f);
-      }
-      if (!r_hit_normals.is_empty()) {
-        r_hit_normals[i] = float3(0.0f, 0.0f, 0.0f);
-      }
-      if (!r_hit_distances.is_empty()) {
-        r_hit_distances[i] = ray_lengths[i];
-      }
-      if (!r_bary_weights.is_empty()) {
-        r_bary_weights[i] = float3(0);
-      }
-    }
-  });
+  tree_data.ray_intersect_batch(
+      mask,
+      [&](const int i) {
+        bke::bvh::Ray ray{};
+        ray.origin = ray_origins[i];
+        ray.direction = ray_directions[i];
+        ray.dist_max = ray_lengths[i];
+        return ray;
+      },
+      [&](const int i, const bke::bvh::Ray &ray, const std::optional<bke::bvh::RayHit> &hit) {
+        if (hit) {
+          if (!r_hit.is_empty()) {
+            r_hit[i] = true;
+          }
+          if (!r_hit_indices.is_empty()) {
+            /* The caller must be able to handle invalid indices anyway, so don't clamp this
+             * value. */
+            r_hit_indices[i] = hit->index;
+          }
+          if (!r_hit_positions.is_empty()) {
+            r_hit_positions[i] = hit->position(ray);
+          }
+          if (!r_hit_normals.is_empty()) {
+            r_hit_normals[i] = math::normalize(hit->normal);
+          }
+          if (!r_hit_distances.is_empty()) {
+            r_hit_distances[i] = hit->distance;
+          }
+          if (!r_bary_weights.is_empty()) {
+            r_bary_weights[i] = hit->bary_coord;
+          }
+        }
+        else {
+          if (!r_hit.is_empty()) {
+            r_hit[i] = false;
+          }
+          if (!r_hit_indices.is_empty()) {
+            r_hit_indices[i] = -1;
+          }
+          if (!r_hit_positions.is_empty()) {
+            r_hit_positions[i] = float3(0.0f, 0.0f, 0.0f);
+          }
+          if (!r_hit_normals.is_empty()) {
+            r_hit_normals[i] = float3(0.0f, 0.0f, 0.0f);
+          }
+          if (!r_hit_distances.is_empty()) {
+            r_hit_distances[i] = ray.dist_max;
+          }
+          if (!r_bary_weights.is_empty()) {
+            r_bary_weights[i] = float3(0);
+          }
+        }
+      });
 }
 
 class RaycastFunction : public mf::MultiFunction {
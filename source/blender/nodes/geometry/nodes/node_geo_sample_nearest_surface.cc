@@ -164,20 +164,8 @@ class SampleNearestSurfaceFunction : public mf::MultiFunction {
     MutableSpan<bool> is_valid_span = params.uninitialized_single_output_if_required<bool>(
         4, "Is Valid");
 
-    mask.foreach_index([&](const int i) {
-      const float3 position = positions[i];
-      const int sample_id = sample_ids[i];
-      const int group_index = group_indices_.index_of_try(sample_id);
-      if (group_index == -1) {
-        triangle_index[i] = -1;
-        bary_weights[i] = float3(0, 0, 0);
-        if (!is_valid_span.is_empty()) {
-          is_valid_span[i] = false;
-        }
-        return;
-      }
-      const bke::bvh::Tree &bvh = single_tree_ ? *single_tree_ : bvh_trees_[group_index];
-      const std::optional<bke::bvh::ClosestPointResult> result = bvh.closest_point(position);
+    const auto write_result = [&](const int i,
+                                  const std::optional<bke::bvh::ClosestPointResult> &result) {
       if (!result) {
         triangle_index[i] = -1;
         bary_weights[i] = float3(0, 0, 0);
@@ -191,6 +179,28 @@ class SampleNearestSurfaceFunction : public mf::MultiFunction {
       if (!is_valid_span.is_empty()) {
         is_valid_span[i] = true;
       }
+    };
+
+    if (single_tree_) {
+      /* All valid samples query the same tree, so they can be processed as one batch. */
+      IndexMaskMemory memory;
+      const IndexMask valid_mask = IndexMask::from_predicate(
+          mask, memory, [&](const int i) { return group_indices_.contains(sample_ids[i]); });
+      valid_mask.complement(mask, memory).foreach_index([&](const int i) {
+        write_result(i, std::nullopt);
+      });
+      single_tree_->closest_point_batch(
+          valid_mask, [&](const int i) { return positions[i]; }, write_result);
+      return;
+    }
+
+    mask.foreach_index([&](const int i) {
+      const int group_index = group_indices_.index_of_try(sample_ids[i]);
+      if (group_index == -1) {
+        write_result(i, std::nullopt);
+        return;
+      }
+      write_result(i, bvh_trees_[group_index].closest_point(positions[i]));
     });
   }
 
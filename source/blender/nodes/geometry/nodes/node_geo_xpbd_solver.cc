@@ -296,7 +296,12 @@ struct DeformingMeshInfo {
    * independent BVH trees for each mesh because the are usually very similar.
    */
   Vector<const bke::bvh::Tree *> substep_corner_tris_bvh_trees;
-  Vector<bke::BVHTreeFromMesh> substep_edges_bvh_trees;
+  /**
+   * A single tree for all substeps. The bounds of each edge enclose the edge in all substeps, so
+   * the tree does not have to be rebuilt when the mesh moves. Edge contacts are computed using the
+   * actual positions in each substep.
+   */
+  std::unique_ptr<BVHTree, BVHTreeDeleter> swept_edges_bvh;
 };
 
 struct MeshCollider {
@@ -953,14 +958,14 @@ class XpbdSolverStep {
   {
     const Mesh *mesh;
     const bke::bvh::Tree *corner_tris_bvh;
-    const bke::BVHTreeFromMesh *edges_bvh;
+    const BVHTree *edges_bvh;
     Span<float3> prev_vert_positions;
     if (is_deforming) {
       BLI_assert(std::holds_alternative<DeformingMeshInfo>(collider.mesh));
       const auto &deforming_mesh = std::get<DeformingMeshInfo>(collider.mesh);
       mesh = deforming_mesh.substep_meshes[substep.current_i + 1];
       corner_tris_bvh = deforming_mesh.substep_corner_tris_bvh_trees[substep.current_i];
-      edges_bvh = &deforming_mesh.substep_edges_bvh_trees[substep.current_i];
+      edges_bvh = deforming_mesh.swept_edges_bvh.get();
       prev_vert_positions = deforming_mesh.substep_meshes[substep.current_i]->vert_positions();
     }
     else {
@@ -968,7 +973,7 @@ class XpbdSolverStep {
       const auto &static_mesh = std::get<StaticMeshInfo>(collider.mesh);
       mesh = static_mesh.mesh;
       corner_tris_bvh = static_mesh.corner_tris_bvh;
-      edges_bvh = &static_mesh.edges_bvh;
+      edges_bvh = static_mesh.edges_bvh.tree;
     }
     const Span<float3> vert_positions = mesh->vert_positions();
     const Span<int2> edge_verts = mesh->edges();
@@ -1059,7 +1064,7 @@ class XpbdSolverStep {
           prev_face_contacts, prev_face_contacts.mesh_contact_indices.lookup_try(contact_id));
     }
 
-    if (collider.use_edge_contacts) {
+    if (collider.use_edge_contacts && edges_bvh) {
       auto handle_edge = [&](const int geo_contact_id, const int point0, const int point1) {
         if (geo_data.is_hard_pinned[point0] && geo_data.is_hard_pinned[point1]) {
           return;
@@ -1233,7 +1238,7 @@ class XpbdSolverStep {
   std::optional<ClosestMeshEdgeContact> get_closest_mesh_edge_contact(
       const float3 &sample_pos0,
       const float3 &sample_pos1,
-      const bke::BVHTreeFromMesh &edges_bvh,
+      const BVHTree &edges_bvh,
       const Span<int2> edges,
       const Span<float3> vert_positions,
       const float max_distance) const
@@ -1273,7 +1278,7 @@ class XpbdSolverStep {
     hit.index = -1;
     hit.dist = ray_len;
     BLI_bvhtree_ray_cast_ex(
-        edges_bvh.tree, sample_pos0, ray_dir, max_distance, &hit, closest_edge_cb, &user_data, 0);
+        &edges_bvh, sample_pos0, ray_dir, max_distance, &hit, closest_edge_cb, &user_data, 0);
     if (hit.index == -1) {
       return std::nullopt;
     }
@@ -1441,7 +1446,6 @@ class XpbdSolverStep {
     DeformingMeshInfo result;
     result.substep_meshes.resize(substeps_ + 1);
     result.substep_corner_tris_bvh_trees.resize(substeps_);
-    result.substep_edges_bvh_trees.resize(substeps_);
 
     const Span<float3> begin_positions = prev_mesh->vert_positions();
     const Span<float3> end_positions = mesh.vert_positions();
@@ -1477,13 +1481,43 @@ class XpbdSolverStep {
             if (mesh_i > 0) {
               /* The bvh tree is not needed for the first substep. */
               result.substep_corner_tris_bvh_trees[mesh_i - 1] = &substep_mesh->bvh_tris();
-              result.substep_edges_bvh_trees[mesh_i - 1] = substep_mesh->bvh_edges();
             }
           }
         });
+    result.swept_edges_bvh = this->build_swept_edges_bvh(
+        mesh.edges(), begin_positions, end_positions);
     return result;
   }
 
+  /**
+   * Build a tree whose leaves enclose every edge at the positions interpolated at the beginning
+   * and end of the interpolation range. Since the positions are interpolated linearly, the edge
+   * stays within these bounds in every substep.
+   */
+  std::unique_ptr<BVHTree, BVHTreeDeleter> build_swept_edges_bvh(
+      const Span<int2> edges,
+      const Span<float3> begin_positions,
+      const Span<float3> end_positions) const
+  {
+    if (edges.is_empty()) {
+      return nullptr;
+    }
+    std::unique_ptr<BVHTree, BVHTreeDeleter> tree(BLI_bvhtree_new(edges.size(), 0.0f, 2, 6));
+    for (const int edge_i : edges.index_range()) {
+      const int2 &edge = edges[edge_i];
+      float3 co[4];
+      int co_i = 0;
+      for (const float mix_factor : {interpolation_begin_, interpolation_end_}) {
+        for (const int vert : {edge[0], edge[1]}) {
+          co[co_i++] = math::interpolate(begin_positions[vert], end_positions[vert], mix_factor);
+        }
+      }
+      BLI_bvhtree_insert(tree.get(), edge_i, reinterpret_cast<const float *>(co), 4);
+    }
+    BLI_bvhtree_balance(tree.get());
+    return tree;
+  }
+
   void prepare_geometry_chunks()
   {
     constexpr int approx_points_per_chunk = 256;
@@ -22,6 +22,8 @@
 
 #include "DEG_depsgraph_query.hh"
 
+#include "BLI_cache_mutex.hh"
+
 namespace blender::nodes {
 
 using bke::AttrDomain;
@@ -36,6 +38,9 @@ using fn::GField;
 class LazyFunctionForForeachGeometryElementZone;
 struct ForeachGeometryElementEvalStorage;
 
+/** Number of element geometries that are extracted together. */
+static constexpr int element_geometry_chunk_size = 256;
+
 struct ForeachElementComponentID {
   GeometryComponent::Type component_type;
   AttrDomain domain;
@@ -55,10 +60,24 @@ struct ForeachElementComponent {
   std::optional<fn::FieldEvaluator> field_evaluator;
   /** Index values passed into each body node. */
   Array<SocketValueVariant> index_values;
-  /** Evaluated input values passed into each body node. */
+  /**
+   * Evaluated input values passed into each body node. They are released once the body node
+   * copied them.
+   */
   Array<Array<SocketValueVariant>> item_input_values;
-  /** Geometry for each iteration. */
-  std::optional<Array<SocketValueVariant>> element_geometries;
+  /**
+   * Geometry for each iteration, empty if the element geometry is not used. The geometries are
+   * only extracted when the first iteration of a chunk is evaluated, and are moved into the body
+   * node afterwards. That way, only the geometries of the iterations that are currently evaluated
+   * exist at the same time, instead of the geometries of all elements.
+   */
+  Array<std::optional<GeometrySet>> element_geometries;
+  std::unique_ptr<CacheMutex[]> element_geometry_chunk_mutexes;
+  /**
+   * Attributes propagated to mesh element geometries. They are prepared once for all chunks,
+   * because that may interpolate them to another domain for the entire mesh.
+   */
+  std::optional<geometry::MeshElementAttributes> mesh_element_attributes;
   /** The set of body evaluation nodes that correspond to this component. This indexes into
    * `lf_body_nodes`. */
   IndexRange body_nodes_range;
@@ -132,38 +151,18 @@ struct LazyFunctionForReduceForeachGeometryElement : public LazyFunction {
 
 /**
  * This is called whenever an evaluation node is entered. It sets up the compute context if the
- * node is a loop body node.
+ * node is a loop body node and hands over the per-iteration data that is owned by the zone.
  */
 class ForeachGeometryElementNodeExecuteWrapper : public lf::GraphExecutorNodeExecuteWrapper {
  public:
+  const LazyFunctionForForeachGeometryElementZone *zone_fn_ = nullptr;
+  ForeachGeometryElementEvalStorage *eval_storage_ = nullptr;
   const bNode *output_bnode_ = nullptr;
   VectorSet<lf::FunctionNode *> *lf_body_nodes_ = nullptr;
 
   void execute_node(const lf::FunctionNode &node,
                     lf::Params &params,
-                    const lf::Context &context) const override
-  {
-    GeoNodesUserData &user_data = *static_cast<GeoNodesUserData *>(context.user_data);
-    const int index = lf_body_nodes_->index_of_try(const_cast<lf::FunctionNode *>(&node));
-    const LazyFunction &fn = node.function();
-    if (index == -1) {
-      /* The node is not a loop body node, just execute it normally. */
-      fn.execute(params, context);
-      return;
-    }
-
-    /* Setup context for the loop body evaluation. */
-    bke::ForeachGeometryElementZoneComputeContext body_compute_context{
-        user_data.compute_context, *output_bnode_, index};
-    GeoNodesUserData body_user_data = user_data;
-    body_user_data.compute_context = &body_compute_context;
-    body_user_data.verbose_log = should_log_verbose_in_context(user_data,
-                                                               body_compute_context.hash());
-
-    GeoNodesLocalUserData body_local_user_data{body_user_data};
-    lf::Context body_context{context.storage, &body_user_data, &body_local_user_data};
-    fn.execute(params, body_context);
-  }
+                    const lf::Context &context) const override;
 };
 
 /**
@@ -392,6 +391,8 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
     eval_storage.side_effect_provider->lf_body_nodes_ = eval_storage.lf_body_nodes;
 
     eval_storage.body_execute_wrapper.emplace();
+    eval_storage.body_execute_wrapper->zone_fn_ = this;
+    eval_storage.body_execute_wrapper->eval_storage_ = &eval_storage;
     eval_storage.body_execute_wrapper->output_bnode_ = &output_bnode_;
     eval_storage.body_execute_wrapper->lf_body_nodes_ = &eval_storage.lf_body_nodes;
 
@@ -420,9 +421,6 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
   {
     const AttrDomain iteration_domain = AttrDomain(node_storage.domain);
 
-    /* TODO: Get propagation info from input, but that's not necessary for correctness for now. */
-    bke::AttributeFilter attribute_filter;
-
     const bNodeSocket &element_geometry_bsocket = zone_.input_node()->output_socket(1);
     const bool create_element_geometries = element_geometry_bsocket.is_available() &&
                                            element_geometry_bsocket.is_directly_linked();
@@ -500,18 +498,16 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
           [&](const int i, const int pos) { component_info.index_values[pos].set(i); });
 
       if (create_element_geometries) {
-        if (std::optional<Array<GeometrySet>> element_geometries =
-                this->try_extract_element_geometries(
-                    eval_storage.main_geometry, id, mask, attribute_filter))
+        /* The geometries are extracted lazily, see #ensure_element_geometries_chunk. */
+        component_info.element_geometries.reinitialize(mask.size());
+        component_info.element_geometry_chunk_mutexes = std::make_unique<CacheMutex[]>(
+            divide_ceil_ul(mask.size(), element_geometry_chunk_size));
+        if (id.component_type == GeometryComponent::Type::Mesh &&
+            ELEM(id.domain, AttrDomain::Point, AttrDomain::Edge, AttrDomain::Face))
         {
-          component_info.element_geometries.emplace(element_geometries->size());
-          threading::parallel_for(
-              element_geometries->index_range(), 256, [&](const IndexRange range) {
-                for (const int i : range) {
-                  (*component_info.element_geometries)[i] = SocketValueVariant::From(
-                      (*element_geometries)[i]);
-                }
-              });
+          /* TODO: Get propagation info from input, not necessary for correctness for now. */
+          component_info.mesh_element_attributes = geometry::prepare_mesh_element_attributes(
+              *eval_storage.main_geometry.get_mesh(), id.domain, {});
         }
       }
 
@@ -535,27 +531,100 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
     eval_storage.total_iterations_num = body_nodes_offset;
   }
 
+  /**
+   * Make sure that the element geometries of the chunk that contains the given iteration of the
+   * component have been extracted.
+   */
+  void ensure_element_geometries_chunk(const ForeachGeometryElementEvalStorage &eval_storage,
+                                       ForeachElementComponent &component_info,
+                                       const int local_body_i) const
+  {
+    const int chunk_i = local_body_i / element_geometry_chunk_size;
+    component_info.element_geometry_chunk_mutexes[chunk_i].ensure([&]() {
+      const IndexRange chunk_range =
+          IndexRange(int64_t(chunk_i) * element_geometry_chunk_size, element_geometry_chunk_size)
+              .intersect(component_info.element_geometries.index_range());
+      const IndexMask mask = component_info.field_evaluator->get_evaluated_selection_as_mask();
+
+      /* TODO: Get propagation info from input, not necessary for correctness for now. */
+      bke::AttributeFilter attribute_filter;
+      MutableSpan<std::optional<GeometrySet>> dst =
+          component_info.element_geometries.as_mutable_span().slice(chunk_range);
+      if (std::optional<Array<GeometrySet>> element_geometries =
+              this->try_extract_element_geometries(eval_storage.main_geometry,
+                                                   component_info,
+                                                   mask.slice(chunk_range),
+                                                   attribute_filter))
+      {
+        for (const int i : dst.index_range()) {
+          dst[i] = std::move((*element_geometries)[i]);
+        }
+      }
+      else {
+        dst.fill(GeometrySet());
+      }
+    });
+  }
+
+  /**
+   * Pass the data owned by the zone to the loop body. The body node copies its unlinked inputs
+   * before it is executed the first time, so the zone's own copies can be released afterwards.
+   */
+  void prepare_body_inputs(ForeachGeometryElementEvalStorage &eval_storage,
+                           const int body_i,
+                           lf::Params &params) const
+  {
+    for (ForeachElementComponent &component_info : eval_storage.components) {
+      if (!component_info.body_nodes_range.contains(body_i)) {
+        continue;
+      }
+      const int local_body_i = body_i - component_info.body_nodes_range.start();
+      for (Array<SocketValueVariant> &values : component_info.item_input_values) {
+        values[local_body_i] = {};
+      }
+      if (component_info.element_geometries.is_empty()) {
+        return;
+      }
+      this->ensure_element_geometries_chunk(eval_storage, component_info, local_body_i);
+      std::optional<GeometrySet> &element_geometry =
+          component_info.element_geometries[local_body_i];
+      if (element_geometry) {
+        /* Only done when the body is executed the first time. */
+        params.get_input<SocketValueVariant>(body_fn_.indices.inputs.main[1]) =
+            SocketValueVariant::From(std::move(*element_geometry));
+        element_geometry.reset();
+      }
+      return;
+    }
+  }
+
   std::optional<Array<GeometrySet>> try_extract_element_geometries(
       const GeometrySet &main_geometry,
-      const ForeachElementComponentID &id,
+      const ForeachElementComponent &component_info,
       const IndexMask &mask,
       const bke::AttributeFilter &attribute_filter) const
   {
+    const ForeachElementComponentID &id = component_info.id;
     switch (id.component_type) {
       case GeometryComponent::Type::Mesh: {
+        if (!component_info.mesh_element_attributes) {
+          return std::nullopt;
+        }
         const Mesh &main_mesh = *main_geometry.get_mesh();
+        const geometry::MeshElementAttributes &attributes =
+            *component_info.mesh_element_attributes;
         Array<Mesh *> meshes;
         switch (id.domain) {
           case AttrDomain::Point: {
-            meshes = geometry::extract_mesh_vertices(main_mesh, mask, attribute_filter);
+            meshes = geometry::extract_mesh_vertices(main_mesh, mask, attributes);
             break;
           }
           case AttrDomain::Edge: {
-            meshes = geometry::extract_mesh_edges(main_mesh, mask, attribute_filter);
+            meshes = geometry::extract_mesh_edges(main_mesh, mask, attributes);
             break;
           }
           case AttrDomain::Face: {
-            meshes = geometry::extract_mesh_faces(main_mesh, mask, attribute_filter);
+            meshes = geometry::extract_mesh_faces(main_mesh, mask, attributes);
             break;
           }
           default: {
@@ -685,13 +754,11 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
         /* Set index input for loop body. */
         lf_body_node.input(body_fn_.indices.inputs.main[0])
             .set_default_value(&component_info.index_values[i]);
-        /* Set geometry element input for loop body. */
+        /* Set geometry element input for loop body. The actual element geometry is passed in
+         * when the body is executed, see #prepare_body_inputs. */
         if (element_geometry_bsocket.is_available()) {
-          const SocketValueVariant *element_geometry =
-              component_info.element_geometries.has_value() ?
-                  &(*component_info.element_geometries)[i] :
-                  &empty_geometry_value;
-          lf_body_node.input(body_fn_.indices.inputs.main[1]).set_default_value(element_geometry);
+          lf_body_node.input(body_fn_.indices.inputs.main[1])
+              .set_default_value(&empty_geometry_value);
         }
         /* Set main input values for loop body. */
         for (const int item_i : IndexRange(node_storage.input_items.items_num)) {
@@ -781,6 +848,34 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
   }
 };
 
+void ForeachGeometryElementNodeExecuteWrapper::execute_node(const lf::FunctionNode &node,
+                                                            lf::Params &params,
+                                                            const lf::Context &context) const
+{
+  GeoNodesUserData &user_data = *static_cast<GeoNodesUserData *>(context.user_data);
+  const int index = lf_body_nodes_->index_of_try(const_cast<lf::FunctionNode *>(&node));
+  const LazyFunction &fn = node.function();
+  if (index == -1) {
+    /* The node is not a loop body node, just execute it normally. */
+    fn.execute(params, context);
+    return;
+  }
+
+  zone_fn_->prepare_body_inputs(*eval_storage_, index, params);
+
+  /* Setup context for the loop body evaluation. */
+  bke::ForeachGeometryElementZoneComputeContext body_compute_context{
+      user_data.compute_context, *output_bnode_, index};
+  GeoNodesUserData body_user_data = user_data;
+  body_user_data.compute_context = &body_compute_context;
+  body_user_data.verbose_log = should_log_verbose_in_context(user_data,
+                                                             body_compute_context.hash());
+
+  GeoNodesLocalUserData body_local_user_data{body_user_data};
+  lf::Context body_context{context.storage, &body_user_data, &body_local_user_data};
+  fn.execute(params, body_context);
+}
+
 LazyFunctionForReduceForeachGeometryElement::LazyFunctionForReduceForeachGeometryElement(
     const LazyFunctionForForeachGeometryElementZone &parent,
     ForeachGeometryElementEvalStorage &eval_storage)
@@ -26,6 +26,7 @@
 #include "NOD_geometry_nodes_closure.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
 #include "NOD_geometry_nodes_list.hh"
+#include "NOD_geometry_nodes_result_cache.hh"
 #include "NOD_multi_function.hh"
 #include "NOD_node_declaration.hh"
 #include "NOD_shader_nodes_multi_function.hh"
@@ -237,15 +238,23 @@ class LazyFunctionForGeometryNode : public LazyFunction {
       return this->anonymous_attribute_name_for_output(*user_data, i);
     };
 
-    GeoNodeExecParams geo_params{
-        node_,
-        params,
-        context,
-        own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
-        own_lf_graph_info_.mapping.lf_input_index_for_reference_set_for_output,
-        get_anonymous_attribute_name};
+    auto execute_node = [&](lf::Params &exec_params) {
+      GeoNodeExecParams geo_params{
+          node_,
+          exec_params,
+          context,
+          own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
+          own_lf_graph_info_.mapping.lf_input_index_for_reference_set_for_output,
+          get_anonymous_attribute_name};
+      node_.typeinfo->geometry_node_execute(geo_params);
+    };
 
-    node_.typeinfo->geometry_node_execute(geo_params);
+    if (node_result_cache_is_enabled(node_)) {
+      if (execute_node_with_result_cache(node_, *this, params, context, execute_node)) {
+        return;
+      }
+    }
+    execute_node(params);
   }
 
   std::string input_name(const int index) const override
@@ -0,0 +1,351 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <xxhash.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_generic_key.hh"
+#include "BLI_memory_cache.hh"
+#include "BLI_memory_utils.hh"
+#include "BLI_unique_hash.hh"
+
+#include "DNA_node_types.h"
+#include "DNA_userdef_types.h"
+
+#include "BKE_geometry_nodes_reference_set.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_node_socket_value.hh"
+
+#include "FN_field.hh"
+#include "FN_lazy_function_execute.hh"
+
+#include "NOD_eval_log.hh"
+#include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_result_cache.hh"
+#include "NOD_geometry_nodes_values.hh"
+#include "NOD_node_declaration.hh"
+
+namespace blender::nodes {
+
+using bke::GeometryComponent;
+using bke::GeometryNodesReferenceSet;
+using bke::GeometrySet;
+using bke::SocketValueVariant;
+
+/**
+ * Identifies a node evaluation by a hash of the node and all its inputs.
+ */
+class NodeResultCacheKey : public GenericKey {
+ public:
+  UniqueHash unique_hash;
+  /**
+   * Geometry components are hashed by their address and version. Keep them from being freed
+   * entirely while the key exists, so that their memory is not reused by other components.
+   * Their geometry data is still freed as soon as it's not used anymore.
+   */
+  Vector<WeakImplicitSharingPtr> geometry_components;
+  /** Some field inputs are hashed by their address, so keep them alive for the same reason. */
+  Vector<fn::GField> fields;
+
+  uint64_t hash() const override
+  {
+    return unique_hash.hash();
+  }
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    if (const auto *other_typed = dynamic_cast<const NodeResultCacheKey *>(&other)) {
+      return unique_hash == other_typed->unique_hash;
+    }
+    return false;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<NodeResultCacheKey>(*this);
+  }
+};
+
+class CachedNodeResult : public memory_cache::CachedValue {
+ public:
+  /** The values of the outputs that were computed, indexed by lazy-function output. */
+  Array<std::optional<SocketValueVariant>> outputs;
+  /** Warnings created by the node, which have to be logged again when the result is reused. */
+  Vector<NodeWarning> warnings;
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    for (const std::optional<SocketValueVariant> &value : this->outputs) {
+      if (value) {
+        value->count_memory(memory);
+      }
+    }
+  }
+};
+
+static void hash_string(const StringRef str, UniqueHashBytes &hash)
+{
+  hash.add(str.size());
+  hash.data.extend(reinterpret_cast<const std::byte *>(str.data()), str.size());
+}
+
+static bool hash_geometry(const GeometrySet &geometry,
+                          UniqueHashBytes &hash,
+                          NodeResultCacheKey &key)
+{
+  if (geometry.has_bundle()) {
+    return false;
+  }
+  hash_string(geometry.name(), hash);
+  for (const GeometryComponent *component : geometry.get_components()) {
+    /* The version changes whenever the component is modified in place. */
+    hash.add(component);
+    hash.add(component->version());
+    component->add_weak_user();
+    key.geometry_components.append(WeakImplicitSharingPtr(component));
+  }
+  return true;
+}
+
+static bool hash_socket_value(const SocketValueVariant &value,
+                              UniqueHashBytes &hash,
+                              NodeResultCacheKey &key,
+                              fn::FieldHashDeep &field_hash)
+{
+  const eNodeSocketDatatype socket_type = value.socket_type();
+  hash.add(socket_type);
+  if (value.is_field()) {
+    fn::GField field = value.get<fn::GField>();
+    hash.add(field_hash.ensure(field));
+    key.fields.append(std::move(field));
+    return true;
+  }
+  if (!value.is_single()) {
+    /* Grids and lists are not supported yet. */
+    return false;
+  }
+  switch (socket_type) {
+    case SOCK_GEOMETRY:
+      return hash_geometry(value.get<GeometrySet>(), hash, key);
+    case SOCK_OBJECT:
+    case SOCK_COLLECTION:
+    case SOCK_TEXTURE:
+    case SOCK_IMAGE:
+    case SOCK_MATERIAL:
+    case SOCK_BUNDLE:
+    case SOCK_CLOSURE:
+      /* The data referenced by these may change without the pointer changing. */
+      return false;
+    default:
+      break;
+  }
+  const GPointer single_value = value.get_single_ptr();
+  if (!single_value.type()->is_hashable()) {
+    return false;
+  }
+  hash.add(single_value.type());
+  single_value.type()->hash_unique(single_value.get(), hash);
+  return true;
+}
+
+static void hash_reference_set(const GeometryNodesReferenceSet &reference_set,
+                               UniqueHashBytes &hash)
+{
+  if (!reference_set.names) {
+    hash.add(int64_t(0));
+    return;
+  }
+  Vector<StringRef> names(reference_set.names->begin(), reference_set.names->end());
+  std::sort(names.begin(), names.end());
+  hash.add(names.size());
+  for (const StringRef name : names) {
+    hash_string(name, hash);
+  }
+}
+
+/**
+ * Properties are stored in various places in the node. Hash all of them, so that changing any
+ * property invalidates cached results.
+ */
+static void hash_node_properties(const bNode &node, UniqueHashBytes &hash)
+{
+  hash.add(node.typeinfo);
+  hash.add(node.custom1);
+  hash.add(node.custom2);
+  hash.add(node.custom3);
+  hash.add(node.custom4);
+  if (node.storage) {
+    const size_t storage_size = MEM_allocN_len(node.storage);
+    hash.add(storage_size);
+    hash.data.extend(static_cast<const std::byte *>(node.storage), int64_t(storage_size));
+  }
+}
+
+static std::optional<NodeResultCacheKey> build_key(const bNode &node,
+                                                   const lf::LazyFunction &fn,
+                                                   const lf::Params &params,
+                                                   const GeoNodesUserData &user_data,
+                                                   const bool use_logging)
+{
+  NodeResultCacheKey key;
+  UniqueHashBytes hash;
+
+  /* Anonymous attribute names created by the node depend on the compute context and node. */
+  hash.add(user_data.compute_context->hash());
+  hash.add(node.identifier);
+  hash_node_properties(node, hash);
+  /* Warnings are only gathered when logging is enabled. */
+  hash.add(use_logging);
+
+  fn::FieldHashDeep field_hash;
+  for (const int i : fn.inputs().index_range()) {
+    const CPPType &type = *fn.inputs()[i].type;
+    const void *value = params.try_get_input_data_ptr(i);
+    BLI_assert(value != nullptr);
+    if (type.is<SocketValueVariant>()) {
+      const auto &value_variant = *static_cast<const SocketValueVariant *>(value);
+      if (!hash_socket_value(value_variant, hash, key, field_hash)) {
+        return std::nullopt;
+      }
+    }
+    else if (type.is<GeoNodesMultiInput<SocketValueVariant>>()) {
+      const auto &multi_input = *static_cast<const GeoNodesMultiInput<SocketValueVariant> *>(
+          value);
+      hash.add(multi_input.values.size());
+      for (const SocketValueVariant &value_variant : multi_input.values) {
+        if (!hash_socket_value(value_variant, hash, key, field_hash)) {
+          return std::nullopt;
+        }
+      }
+    }
+    else if (type.is<bool>()) {
+      hash.add(*static_cast<const bool *>(value));
+    }
+    else if (type.is<GeometryNodesReferenceSet>()) {
+      hash_reference_set(*static_cast<const GeometryNodesReferenceSet *>(value), hash);
+    }
+    else {
+      return std::nullopt;
+    }
+  }
+  for (const int i : fn.outputs().index_range()) {
+    if (!fn.outputs()[i].type->is<SocketValueVariant>()) {
+      return std::nullopt;
+    }
+    /* Nodes may skip computing outputs that are not used. */
+    hash.add(params.get_output_usage(i) != lf::ValueUsage::Unused);
+  }
+
+  const Span<std::byte> bytes = hash.data.as_span();
+  const XXH128_hash_t xxhash = XXH3_128bits(bytes.data(), bytes.size());
+  static_assert(sizeof(UniqueHash) == sizeof(xxhash));
+  memcpy(static_cast<void *>(&key.unique_hash), &xxhash, sizeof(xxhash));
+  return key;
+}
+
+bool node_result_cache_is_enabled(const bNode &node)
+{
+  if (!USER_EXPERIMENTAL_TEST(&U, use_geometry_nodes_result_cache)) {
+    return false;
+  }
+  const NodeDeclaration *declaration = node.declaration();
+  return declaration && declaration->supports_result_cache;
+}
+
+static std::unique_ptr<CachedNodeResult> execute_to_cached_result(
+    const bNode &node,
+    const lf::LazyFunction &fn,
+    lf::Params &params,
+    eval_log::NodeTreeLogger *tree_logger,
+    const FunctionRef<void(lf::Params &params)> execute_fn)
+{
+  const int inputs_num = fn.inputs().size();
+  const int outputs_num = fn.outputs().size();
+
+  /* Execute the node with separate output storage so that the results can be copied into the
+   * cache before they are passed on. The inputs are passed through directly. */
+  Array<GMutablePointer> inputs(inputs_num);
+  for (const int i : IndexRange(inputs_num)) {
+    inputs[i] = {*fn.inputs()[i].type, params.try_get_input_data_ptr(i)};
+  }
+  Array<TypedBuffer<SocketValueVariant>> output_buffers(outputs_num);
+  Array<GMutablePointer> outputs(outputs_num);
+  Array<lf::ValueUsage> output_usages(outputs_num);
+  for (const int i : IndexRange(outputs_num)) {
+    outputs[i] = {CPPType::get<SocketValueVariant>(), output_buffers[i].ptr()};
+    output_usages[i] = params.get_output_usage(i);
+  }
+  Array<std::optional<lf::ValueUsage>> input_usages(inputs_num);
+  Array<bool> set_outputs(outputs_num, false);
+  lf::BasicParams local_params{fn, inputs, outputs, input_usages, output_usages, set_outputs};
+
+  execute_fn(local_params);
+
+  auto result = std::make_unique<CachedNodeResult>();
+  result->outputs.reinitialize(outputs_num);
+  for (const int i : IndexRange(outputs_num)) {
+    if (set_outputs[i]) {
+      result->outputs[i].emplace(std::move(*output_buffers[i]));
+      std::destroy_at(output_buffers[i].ptr());
+    }
+  }
+  if (tree_logger) {
+    /* A node is only executed once per compute context, so all its warnings in the logger come
+     * from this evaluation. */
+    for (const eval_log::NodeTreeLogger::WarningWithNode &warning : tree_logger->node_warnings) {
+      if (warning.node_id == node.identifier) {
+        result->warnings.append(warning.warning);
+      }
+    }
+  }
+  return result;
+}
+
+bool execute_node_with_result_cache(const bNode &node,
+                                    const lf::LazyFunction &fn,
+                                    lf::Params &params,
+                                    const lf::Context &context,
+                                    const FunctionRef<void(lf::Params &params)> execute_fn)
+{
+  const auto &user_data = static_cast<const GeoNodesUserData &>(*context.user_data);
+  const auto &local_user_data = static_cast<const GeoNodesLocalUserData &>(
+      *context.local_user_data);
+  eval_log::NodeTreeLogger *tree_logger = local_user_data.try_get_tree_logger(user_data);
+
+  const std::optional<NodeResultCacheKey> key = build_key(
+      node, fn, params, user_data, tree_logger != nullptr);
+  if (!key) {
+    return false;
+  }
+
+  bool computed = false;
+  const std::shared_ptr<const CachedNodeResult> result = memory_cache::get<CachedNodeResult>(
+      *key, [&]() {
+        computed = true;
+        return execute_to_cached_result(node, fn, params, tree_logger, execute_fn);
+      });
+
+  for (const int i : result->outputs.index_range()) {
+    const std::optional<SocketValueVariant> &value = result->outputs[i];
+    if (!value || params.output_was_set(i)) {
+      continue;
+    }
+    if (params.get_output_usage(i) == lf::ValueUsage::Unused) {
+      continue;
+    }
+    params.set_output(i, SocketValueVariant(*value));
+  }
+
+  if (!computed && tree_logger) {
+    for (const NodeWarning &warning : result->warnings) {
+      tree_logger->node_warnings.append(
+          *tree_logger->allocator,
+          {node.identifier, {warning.type, tree_logger->allocator->copy_string(warning.message)}});
+    }
+  }
+  return true;
+}
+
+}  // namespace blender::nodes
@@ -139,6 +139,11 @@ void NodeDeclarationBuilder::allow_any_socket_order(bool enable)
   declaration_.allow_any_socket_order = enable;
 }
 
+void NodeDeclarationBuilder::supports_result_cache(bool enable)
+{
+  declaration_.supports_result_cache = enable;
+}
+
 Span<SocketDeclaration *> NodeDeclaration::sockets(eNodeSocketInOut in_out) const
 {
   if (in_out == SOCK_IN) {
@@ -2510,6 +2510,12 @@ void RE_RenderAnim(Render *re,
   DEG_graph_id_tag_update(re->main, re->pipeline_depsgraph, &re->scene->id, ID_RECALC_AUDIO_MUTE);
 
   scene->r.subframe = 0.0f;
+  /* NOTE: Frames are evaluated one after another on the single pipeline depsgraph. Evaluating a
+   * window of frames ahead in separate depsgraphs is not possible here yet: the frame is stored
+   * in the original scene (`scene->r.cfra`), render layer settings are animated on the original
+   * scene before the depsgraph update, the render callbacks (which may run Python) expect the
+   * scene to be on the frame that is being rendered, and simulations and point caches depend on
+   * frames being evaluated in order. */
   for (nfra = sfra, scene->r.cfra = sfra; scene->r.cfra <= efra; scene->r.cfra++) {
     CLOG_INFO(&LOG, "Rendering frame %d", nfra);
 
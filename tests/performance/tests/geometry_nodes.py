@@ -74,6 +74,12 @@ def _run(args):
         elapsed_time = time.time() - start_time
         return {'time': elapsed_time}
 
+    return _measure_updates(bpy)
+
+
+def _measure_updates(bpy):
+    import time
+
     test_time_start = time.time()
     measured_times = []
 
@@ -104,6 +110,65 @@ def _run(args):
     return result
 
 
+def _run_many_cheap_nodes(args):
+    # Measure the scheduling overhead of the lazy-function graph executor with a node group that
+    # contains thousands of nodes that only do trivial work on single values.
+    import bpy
+
+    columns_num = args["columns_num"]
+    rows_num = args["rows_num"]
+
+    tree = bpy.data.node_groups.new("Many Cheap Nodes", 'GeometryNodeTree')
+    tree.interface.new_socket("Geometry", in_out='INPUT', socket_type='NodeSocketGeometry')
+    tree.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
+    group_input = tree.nodes.new('NodeGroupInput')
+    group_output = tree.nodes.new('NodeGroupOutput')
+
+    def new_math_node(a, b):
+        node = tree.nodes.new('ShaderNodeMath')
+        node.operation = 'ADD'
+        if a is None:
+            node.inputs[0].default_value = 1.0
+        else:
+            tree.links.new(a, node.inputs[0])
+        if b is None:
+            node.inputs[1].default_value = 1.0
+        else:
+            tree.links.new(b, node.inputs[1])
+        return node.outputs[0]
+
+    # Many independent chains of nodes, which are summed up at the end so that all of them are used.
+    column_results = []
+    for _ in range(columns_num):
+        value = None
+        for _ in range(rows_num):
+            value = new_math_node(value, None)
+        column_results.append(value)
+    while len(column_results) > 1:
+        summed_results = []
+        for i in range(0, len(column_results) - 1, 2):
+            summed_results.append(new_math_node(column_results[i], column_results[i + 1]))
+        if len(column_results) % 2 == 1:
+            summed_results.append(column_results[-1])
+        column_results = summed_results
+
+    combine = tree.nodes.new('ShaderNodeCombineXYZ')
+    tree.links.new(column_results[0], combine.inputs[0])
+    transform = tree.nodes.new('GeometryNodeTransform')
+    tree.links.new(group_input.outputs[0], transform.inputs["Geometry"])
+    tree.links.new(combine.outputs[0], transform.inputs["Translation"])
+    tree.links.new(transform.outputs[0], group_output.inputs[0])
+
+    ob = bpy.data.objects["Cube"]
+    modifier = ob.modifiers.new(name="Many Cheap Nodes", type='NODES')
+    modifier.node_group = tree
+
+    # Evaluate objects once first, to avoid any possible lazy evaluation later.
+    bpy.context.view_layer.update()
+
+    return _measure_updates(bpy)
+
+
 class GeometryNodesTest(api.Test):
     def __init__(self, filepath):
         self.filepath = filepath
@@ -122,6 +187,22 @@ class GeometryNodesTest(api.Test):
         return result
 
 
+class GeometryNodesManyCheapNodesTest(api.Test):
+    def name(self):
+        return "many_cheap_nodes"
+
+    def category(self):
+        return "geometry_nodes"
+
+    def run(self, env, device_id, gpu_backend):
+        # Generates 64 chains of 100 nodes, i.e. about 6500 nodes in total.
+        args = {"columns_num": 64, "rows_num": 100}
+
+        result, _ = env.run_in_blender(_run_many_cheap_nodes, args, ["--factory-startup"])
+
+        return result
+
+
 def generate(env):
     filepaths = env.find_blend_files('geometry_nodes/*')
-    return [GeometryNodesTest(filepath) for filepath in filepaths]
+    return [GeometryNodesTest(filepath) for filepath in filepaths] + [GeometryNodesManyCheapNodesTest()]
@@ -225,7 +225,7 @@ def _run_bvh_test(args: dict):
     return sum(measurements) / len(measurements)
 
 
-def _run_subdivide_test(_args: dict):
+def _run_multires_operator_test(args: dict):
     import bpy
     import time
     context = bpy.context
@@ -246,7 +246,12 @@ def _run_subdivide_test(_args: dict):
         set_view3d_context_override(context_override)
         with context.temp_override(**context_override):
             start = time.time()
-            bpy.ops.object.multires_subdivide(modifier="Multires")
+            if args['operator'] == 'SUBDIVIDE':
+                bpy.ops.object.multires_subdivide(modifier="Multires")
+            elif args['operator'] == 'APPLY_BASE':
+                bpy.ops.object.multires_base_apply(modifier="Multires")
+            else:
+                raise NotImplementedError
             measurements.append(time.time() - start)
 
         if len(measurements) >= min_measurements and (time.time() - total_time_start) > timeout:
@@ -360,7 +365,23 @@ class SculptMultiresSubdivideTest(api.Test):
         return "sculpt"
 
     def run(self, env, _device_id, _gpu_backend):
-        result, _ = env.run_in_blender(_run_subdivide_test, {}, [self.filepath])
+        result, _ = env.run_in_blender(_run_multires_operator_test, {'operator': 'SUBDIVIDE'}, [self.filepath])
+
+        return {'time': result}
+
+
+class SculptMultiresApplyBaseTest(api.Test):
+    def __init__(self, filepath: pathlib.Path):
+        self.filepath = filepath
+
+    def name(self):
+        return "multires_apply_base_2"
+
+    def category(self):
+        return "sculpt"
+
+    def run(self, env, _device_id, _gpu_backend):
+        result, _ = env.run_in_blender(_run_multires_operator_test, {'operator': 'APPLY_BASE'}, [self.filepath])
 
         return {'time': result}
 
@@ -378,5 +399,5 @@ def generate(env):
             brush_type)for brush_type in BrushType]
     bvh_tests = [SculptRebuildBVHTest(filepaths[0], mode) for mode in SculptMode]
     spatial_bvh_tests = [SculptRebuildSpatialBVHTest(filepaths[0], SculptMode.MESH)]
-    subdivision_tests = [SculptMultiresSubdivideTest(filepaths[0])]
+    subdivision_tests = [SculptMultiresSubdivideTest(filepaths[0]), SculptMultiresApplyBaseTest(filepaths[0])]
     return brush_tests + brush_tests_after_reordering + bvh_tests + spatial_bvh_tests + subdivision_tests